@@ -0,0 +1,172 @@
+// BitSet.cpp
+#include "BitSet.h"
+#include <algorithm>
+#include <numeric>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+DenseBitSet::DenseBitSet(size_t universe)
+    : bits(universe), words((universe + 255) / 256 * 4, 0) {}
+
+size_t DenseBitSet::count() const {
+    size_t n = 0;
+    for (uint64_t w : words) n += (size_t)__builtin_popcountll(w);
+    return n;
+}
+
+size_t DenseBitSet::findNext(size_t i) const {
+    if (i >= bits) return bits;
+    size_t w = i >> 6;
+    uint64_t x = words[w] & (~uint64_t(0) << (i & 63));
+    while (!x) {
+        if (++w == words.size()) return bits;
+        x = words[w];
+    }
+    return w * 64 + (size_t)__builtin_ctzll(x);
+}
+
+void DenseBitSet::clear() { std::fill(words.begin(), words.end(), 0); }
+
+void DenseBitSet::fill() {
+    clear();
+    std::fill(words.begin(), words.begin() + (long)(bits / 64), ~uint64_t(0));
+    if (bits % 64) words[bits / 64] = (uint64_t(1) << (bits % 64)) - 1;
+}
+
+// 三个整体运算都边写结果边把新旧值的异或累积起来，最后一次判断是否改变
+#if defined(__AVX2__)
+
+static inline __m256i load(const uint64_t *p) { return _mm256_loadu_si256((const __m256i *)p); }
+static inline void store(uint64_t *p, __m256i v) { _mm256_storeu_si256((__m256i *)p, v); }
+
+bool DenseBitSet::unionWith(const DenseBitSet &o) {
+    __m256i diff = _mm256_setzero_si256();
+    for (size_t i = 0; i < words.size(); i += 4) {
+        __m256i old = load(&words[i]);
+        __m256i now = _mm256_or_si256(old, load(&o.words[i]));
+        diff = _mm256_or_si256(diff, _mm256_xor_si256(old, now));
+        store(&words[i], now);
+    }
+    return !_mm256_testz_si256(diff, diff);
+}
+
+bool DenseBitSet::intersectWith(const DenseBitSet &o) {
+    __m256i diff = _mm256_setzero_si256();
+    for (size_t i = 0; i < words.size(); i += 4) {
+        __m256i old = load(&words[i]);
+        __m256i now = _mm256_and_si256(old, load(&o.words[i]));
+        diff = _mm256_or_si256(diff, _mm256_xor_si256(old, now));
+        store(&words[i], now);
+    }
+    return !_mm256_testz_si256(diff, diff);
+}
+
+bool DenseBitSet::transfer(const DenseBitSet &gen, const DenseBitSet &in, const DenseBitSet &kill) {
+    __m256i diff = _mm256_setzero_si256();
+    for (size_t i = 0; i < words.size(); i += 4) {
+        __m256i old = load(&words[i]);
+        // andnot(a, b) = ~a & b
+        __m256i now = _mm256_or_si256(load(&gen.words[i]), _mm256_andnot_si256(load(&kill.words[i]), load(&in.words[i])));
+        diff = _mm256_or_si256(diff, _mm256_xor_si256(old, now));
+        store(&words[i], now);
+    }
+    return !_mm256_testz_si256(diff, diff);
+}
+
+#else
+
+bool DenseBitSet::unionWith(const DenseBitSet &o) {
+    uint64_t diff = 0;
+    for (size_t i = 0; i < words.size(); ++i) {
+        uint64_t now = words[i] | o.words[i];
+        diff |= words[i] ^ now;
+        words[i] = now;
+    }
+    return diff != 0;
+}
+
+bool DenseBitSet::intersectWith(const DenseBitSet &o) {
+    uint64_t diff = 0;
+    for (size_t i = 0; i < words.size(); ++i) {
+        uint64_t now = words[i] & o.words[i];
+        diff |= words[i] ^ now;
+        words[i] = now;
+    }
+    return diff != 0;
+}
+
+bool DenseBitSet::transfer(const DenseBitSet &gen, const DenseBitSet &in, const DenseBitSet &kill) {
+    uint64_t diff = 0;
+    for (size_t i = 0; i < words.size(); ++i) {
+        uint64_t now = gen.words[i] | (in.words[i] & ~kill.words[i]);
+        diff |= words[i] ^ now;
+        words[i] = now;
+    }
+    return diff != 0;
+}
+
+#endif
+
+bool SparseBitSet::test(size_t i) const {
+    return std::binary_search(elems.begin(), elems.end(), (uint32_t)i);
+}
+
+void SparseBitSet::set(size_t i) {
+    auto it = std::lower_bound(elems.begin(), elems.end(), (uint32_t)i);
+    if (it == elems.end() || *it != (uint32_t)i) elems.insert(it, (uint32_t)i);
+}
+
+void SparseBitSet::reset(size_t i) {
+    auto it = std::lower_bound(elems.begin(), elems.end(), (uint32_t)i);
+    if (it != elems.end() && *it == (uint32_t)i) elems.erase(it);
+}
+
+void SparseBitSet::fill() {
+    elems.resize(bits);
+    std::iota(elems.begin(), elems.end(), 0u);
+}
+
+// 归并结果先写进线程私有的缓冲区，再与 elems 交换，反复求解时不再分配内存
+static std::vector<uint32_t> &scratch() {
+    static thread_local std::vector<uint32_t> buf;
+    buf.clear();
+    return buf;
+}
+
+bool SparseBitSet::unionWith(const SparseBitSet &o) {
+    if (o.elems.empty()) return false;
+    std::vector<uint32_t> &r = scratch();
+    std::set_union(elems.begin(), elems.end(), o.elems.begin(), o.elems.end(), std::back_inserter(r));
+    // 并集只会变大，元素个数不变即没有改变
+    if (r.size() == elems.size()) return false;
+    elems.swap(r);
+    return true;
+}
+
+bool SparseBitSet::intersectWith(const SparseBitSet &o) {
+    if (elems.empty()) return false;
+    std::vector<uint32_t> &r = scratch();
+    std::set_intersection(elems.begin(), elems.end(), o.elems.begin(), o.elems.end(), std::back_inserter(r));
+    if (r.size() == elems.size()) return false;
+    elems.swap(r);
+    return true;
+}
+
+bool SparseBitSet::transfer(const SparseBitSet &gen, const SparseBitSet &in, const SparseBitSet &kill) {
+    std::vector<uint32_t> &r = scratch();
+    // 一趟归并算出 gen ∪ (in − kill)
+    auto g = gen.elems.begin(), ge = gen.elems.end();
+    auto k = kill.elems.begin(), ke = kill.elems.end();
+    for (uint32_t e : in.elems) {
+        while (k != ke && *k < e) ++k;
+        if (k != ke && *k == e) continue;
+        while (g != ge && *g < e) r.push_back(*g++);
+        if (g != ge && *g == e) ++g;
+        r.push_back(e);
+    }
+    r.insert(r.end(), g, ge);
+    if (r == elems) return false;
+    elems.swap(r);
+    return true;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// 数据流分析用的两种位集，接口相同，求解器对两者都适用。
+// 修改集合的整体运算都返回集合是否改变，求解器据此决定是否把后继加入工作表
+
+// 稠密位集：按 64 位字存放，字数补齐到 4 的倍数，AVX2 每次处理 4 个字时不用单独处理尾部。
+// 整体运算有 AVX2 和标量两种实现，打开 DATAFLOW_AVX2 构建选项时用 AVX2
+class DenseBitSet {
+public:
+    explicit DenseBitSet(size_t universe = 0);
+
+    size_t universe() const { return bits; }
+    bool test(size_t i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+    void set(size_t i) { words[i >> 6] |= uint64_t(1) << (i & 63); }
+    void reset(size_t i) { words[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+    size_t count() const;
+    // 从 i 开始第一个属于集合的元素，没有时返回 universe()
+    size_t findNext(size_t i) const;
+
+    void clear();
+    void fill();        // 变为全集，超出 universe 的位保持为 0
+    bool unionWith(const DenseBitSet &o);
+    bool intersectWith(const DenseBitSet &o);
+    // *this = gen ∪ (in − kill)
+    bool transfer(const DenseBitSet &gen, const DenseBitSet &in, const DenseBitSet &kill);
+
+    bool operator==(const DenseBitSet &o) const { return bits == o.bits && words == o.words; }
+    bool operator!=(const DenseBitSet &o) const { return !(*this == o); }
+
+    template <class F> void forEach(F f) const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (uint64_t x = words[w]; x; x &= x - 1) f(w * 64 + (size_t)__builtin_ctzll(x));
+        }
+    }
+
+private:
+    size_t bits;
+    std::vector<uint64_t> words;
+};
+
+// 稀疏位集：升序存放元素编号。全集很大而每个集合只有少数元素时
+// （例如上万个临时变量的活跃性）比稠密位集省得多，整体运算是有序归并。
+// fill() 要真的列出全部元素，交集类问题在大全集上仍应使用稠密位集
+class SparseBitSet {
+public:
+    explicit SparseBitSet(size_t universe = 0) : bits(universe) {}
+
+    size_t universe() const { return bits; }
+    bool test(size_t i) const;
+    void set(size_t i);
+    void reset(size_t i);
+    size_t count() const { return elems.size(); }
+
+    void clear() { elems.clear(); }
+    void fill();
+    bool unionWith(const SparseBitSet &o);
+    bool intersectWith(const SparseBitSet &o);
+    bool transfer(const SparseBitSet &gen, const SparseBitSet &in, const SparseBitSet &kill);
+
+    bool operator==(const SparseBitSet &o) const { return bits == o.bits && elems == o.elems; }
+    bool operator!=(const SparseBitSet &o) const { return !(*this == o); }
+
+    template <class F> void forEach(F f) const {
+        for (uint32_t e : elems) f((size_t)e);
+    }
+
+private:
+    size_t bits;
+    std::vector<uint32_t> elems;
+};
@@ -6,9 +6,9 @@ int main(int argc, char **argv) {
     std::string infile = "testfile.txt";
     if (argc >= 2) infile = argv[1];
 
-    Lexer lexer(infile);
-    lexer.tokenize();
-    lexer.writeOutputs("lexer.txt", "error.txt");
+    Diagnostics diag;
+    Lexer lexer(infile, diag);
+    lexer.streamOutputs("lexer.txt", "error.txt");
 
     // 提示（可删除）
     // std::cout << "Lexing finished. ";
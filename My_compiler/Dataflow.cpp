@@ -0,0 +1,50 @@
+// Dataflow.cpp
+#include "Dataflow.h"
+#include <algorithm>
+#include <utility>
+
+std::vector<int> flowOrder(const FlowGraph &g, bool forward) {
+    size_t n = (size_t)g.size();
+    const std::vector<std::vector<int>> &next = forward ? g.succ : g.pred;
+    std::vector<char> seen(n, 0);
+    std::vector<int> order, post;
+    order.reserve(n);
+    // 显式栈的深度优先，记录每个块下一个要看的邻居，块数上十万也不会爆栈
+    std::vector<std::pair<int, size_t>> stack;
+    auto dfs = [&](int root) {
+        seen[(size_t)root] = 1;
+        stack.emplace_back(root, 0);
+        while (!stack.empty()) {
+            int b = stack.back().first;
+            size_t &k = stack.back().second;
+            if (k < next[(size_t)b].size()) {
+                int s = next[(size_t)b][k++];
+                if (!seen[(size_t)s]) {
+                    seen[(size_t)s] = 1;
+                    stack.emplace_back(s, 0);
+                }
+            } else {
+                post.push_back(b);
+                stack.pop_back();
+            }
+        }
+    };
+    auto flush = [&]() {
+        order.insert(order.end(), post.rbegin(), post.rend());
+        post.clear();
+    };
+
+    if (forward) {
+        if (n > 0) dfs(g.entry);
+    } else {
+        for (size_t b = 0; b < n; ++b)
+            if (g.succ[b].empty()) dfs((int)b);
+    }
+    flush();
+    for (size_t b = 0; b < n; ++b) {
+        if (seen[b]) continue;
+        dfs((int)b);
+        flush();
+    }
+    return order;
+}
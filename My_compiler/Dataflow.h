@@ -0,0 +1,101 @@
+#pragma once
+#include "BitSet.h"
+#include <vector>
+
+// 基本块组成的控制流图，块编号 0..n-1
+struct FlowGraph {
+    std::vector<std::vector<int>> succ, pred;
+    int entry = 0;
+
+    explicit FlowGraph(int blocks = 0) : succ((size_t)blocks), pred((size_t)blocks) {}
+    int size() const { return (int)succ.size(); }
+    void addEdge(int from, int to) {
+        succ[(size_t)from].push_back(to);
+        pred[(size_t)to].push_back(from);
+    }
+};
+
+// 按数据流方向排出的逆后序：前向问题从入口沿后继深度优先，
+// 后向问题从各个出口（没有后继的块）沿前驱深度优先。
+// 走不到的块按同样方式排在后面，每个块都恰好出现一次
+std::vector<int> flowOrder(const FlowGraph &g, bool forward);
+
+enum class FlowDirection { Forward, Backward };
+enum class FlowMeet { Union, Intersection };
+
+// gen/kill 形式的数据流问题，常见的几种：
+//   活跃变量   Backward + Union        gen = 先用后定值的变量，kill = 定值的变量
+//   到达定义   Forward  + Union        gen = 块内最后的定义，kill = 同一变量的其他定义
+//   可用表达式 Forward  + Intersection gen = 块内计算且之后操作数未被改写的表达式
+template <class Set>
+struct FlowProblem {
+    FlowDirection direction;
+    FlowMeet meet;
+    size_t universe;
+    std::vector<Set> gen, kill;   // 每块一个，初始为空集
+    Set boundary;                 // 前向为入口的 in，后向为出口的 out，初始为空集
+
+    FlowProblem(FlowDirection direction, FlowMeet meet, size_t universe, int blocks)
+        : direction(direction), meet(meet), universe(universe),
+          gen((size_t)blocks, Set(universe)), kill((size_t)blocks, Set(universe)), boundary(universe) {}
+};
+
+template <class Set>
+struct FlowResult {
+    std::vector<Set> in, out;
+    long visits = 0;              // 重新计算过的块次数
+};
+
+// 工作表算法。工作表是按逆后序位置编号的位集，游标循环向后扫描，
+// 每轮总按逆后序处理待算块，无环部分一遍即可稳定，循环只需多绕几圈。
+// 交汇为并集时从空集出发求最小不动点，为交集时除边界外从全集出发求最大不动点
+template <class Set>
+FlowResult<Set> solveDataflow(const FlowGraph &g, const FlowProblem<Set> &p) {
+    bool forward = p.direction == FlowDirection::Forward;
+    bool isUnion = p.meet == FlowMeet::Union;
+    size_t n = (size_t)g.size();
+
+    FlowResult<Set> r;
+    Set init(p.universe);
+    if (!isUnion) init.fill();
+    r.in.assign(n, init);
+    r.out.assign(n, init);
+    const std::vector<std::vector<int>> &from = forward ? g.pred : g.succ;  // 交汇的来源
+    const std::vector<std::vector<int>> &to = forward ? g.succ : g.pred;    // 结果改变后要重算的块
+    std::vector<Set> &meetSets = forward ? r.in : r.out;
+    std::vector<Set> &flowSets = forward ? r.out : r.in;
+
+    std::vector<int> order = flowOrder(g, forward);
+    std::vector<size_t> pos(n);
+    for (size_t i = 0; i < n; ++i) pos[(size_t)order[i]] = i;
+    DenseBitSet pending(n);
+    pending.fill();
+    size_t left = n, cursor = 0;
+    while (left > 0) {
+        cursor = pending.findNext(cursor);
+        if (cursor == n) cursor = pending.findNext(0);
+        pending.reset(cursor);
+        --left;
+        size_t b = (size_t)order[cursor];
+        ++r.visits;
+
+        Set &m = meetSets[b];
+        bool boundary = forward ? (int)b == g.entry : g.succ[b].empty();
+        if (boundary) m = p.boundary;
+        else if (isUnion) m.clear();
+        else m.fill();
+        for (int q : from[b]) {
+            if (isUnion) m.unionWith(flowSets[(size_t)q]);
+            else m.intersectWith(flowSets[(size_t)q]);
+        }
+        if (!flowSets[b].transfer(p.gen[b], m, p.kill[b])) continue;
+        for (int s : to[b]) {
+            size_t k = pos[(size_t)s];
+            if (!pending.test(k)) {
+                pending.set(k);
+                ++left;
+            }
+        }
+    }
+    return r;
+}
@@ -0,0 +1,215 @@
+#include "Dataflow.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// 与位集类型无关的问题描述，分别用两种位集建出同一个问题来比较
+struct Spec {
+    std::string name;
+    FlowDirection direction;
+    FlowMeet meet;
+    size_t universe;
+    std::vector<std::vector<size_t>> gen, kill;
+};
+
+// 合成的大函数：顺序块、if/else 和循环随机嵌套成结构化的控制流图。
+// 每块定值两个新临时变量，只使用支配它的块里最近定值的临时变量，
+// 与前端翻译表达式产生的临时变量一样，活跃范围都很短
+class Synthetic {
+public:
+    FlowGraph graph;
+    std::vector<std::vector<size_t>> tempUses;   // 每块使用的临时变量，块 b 定值 2b 和 2b+1
+
+    Synthetic(int target, std::mt19937 &rng) : rng(rng) {
+        int last = -1;
+        while ((int)tempUses.size() < target) {
+            auto r = region(4);
+            if (last >= 0) edges.emplace_back(last, r.first);
+            last = r.second;
+        }
+        graph = FlowGraph((int)tempUses.size());
+        for (auto &e : edges) graph.addEdge(e.first, e.second);
+    }
+    int blocks() const { return graph.size(); }
+
+private:
+    std::mt19937 &rng;
+    std::vector<std::pair<int, int>> edges;
+    std::vector<size_t> avail;   // 支配当前位置的块定值的临时变量
+
+    int rand(int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); }
+
+    int newBlock() {
+        int b = (int)tempUses.size();
+        std::vector<size_t> uses;
+        for (int k = 0; k < 2 && !avail.empty(); ++k) {
+            int recent = std::min((int)avail.size(), 16);
+            uses.push_back(avail[avail.size() - (size_t)rand(1, recent)]);
+        }
+        tempUses.push_back(uses);
+        avail.push_back(2 * (size_t)b);
+        avail.push_back(2 * (size_t)b + 1);
+        return b;
+    }
+
+    // 生成一段单入口单出口的区域，返回入口块和出口块
+    std::pair<int, int> region(int depth) {
+        int k = rand(0, 99);
+        if (depth == 0 || k < 50) {
+            int b = newBlock();
+            return {b, b};
+        }
+        int head = newBlock();
+        size_t mark = avail.size();
+        if (k < 80) {
+            // 分支内定值的临时变量不支配汇合点
+            auto thenPart = sequence(depth - 1);
+            avail.resize(mark);
+            bool hasElse = rand(0, 1) == 1;
+            std::pair<int, int> elsePart;
+            if (hasElse) elsePart = sequence(depth - 1);
+            avail.resize(mark);
+            int join = newBlock();
+            edges.emplace_back(head, thenPart.first);
+            edges.emplace_back(thenPart.second, join);
+            if (hasElse) {
+                edges.emplace_back(head, elsePart.first);
+                edges.emplace_back(elsePart.second, join);
+            } else {
+                edges.emplace_back(head, join);
+            }
+            return {head, join};
+        }
+        // 循环：头块判断条件，循环体末尾跳回头块
+        auto body = sequence(depth - 1);
+        avail.resize(mark);
+        int exit = newBlock();
+        edges.emplace_back(head, body.first);
+        edges.emplace_back(body.second, head);
+        edges.emplace_back(head, exit);
+        return {head, exit};
+    }
+
+    std::pair<int, int> sequence(int depth) {
+        auto first = region(depth);
+        int last = first.second;
+        for (int i = rand(0, 3); i > 0; --i) {
+            auto r = region(depth);
+            edges.emplace_back(last, r.first);
+            last = r.second;
+        }
+        return {first.first, last};
+    }
+};
+
+Spec makeSpec(const std::string &name, FlowDirection dir, FlowMeet meet, size_t universe, int n) {
+    Spec s{name, dir, meet, universe, {}, {}};
+    s.gen.resize((size_t)n);
+    s.kill.resize((size_t)n);
+    return s;
+}
+
+// 活跃变量：256 个源程序变量，每块用 3 个、定值 2 个
+Spec liveVars(int n, std::mt19937 &rng) {
+    const size_t vars = 256;
+    Spec s = makeSpec("live_vars", FlowDirection::Backward, FlowMeet::Union, vars, n);
+    std::uniform_int_distribution<size_t> pick(0, vars - 1);
+    for (size_t b = 0; b < (size_t)n; ++b) {
+        for (int k = 0; k < 3; ++k) s.gen[b].push_back(pick(rng));
+        for (int k = 0; k < 2; ++k) s.kill[b].push_back(pick(rng));
+    }
+    return s;
+}
+
+// 可用表达式：256 个表达式，每块算出 2 个、使 3 个失效
+Spec availExprs(int n, std::mt19937 &rng) {
+    const size_t exprs = 256;
+    Spec s = makeSpec("avail_exprs", FlowDirection::Forward, FlowMeet::Intersection, exprs, n);
+    std::uniform_int_distribution<size_t> pick(0, exprs - 1);
+    for (size_t b = 0; b < (size_t)n; ++b) {
+        for (int k = 0; k < 2; ++k) s.gen[b].push_back(pick(rng));
+        for (int k = 0; k < 3; ++k) s.kill[b].push_back(pick(rng));
+    }
+    return s;
+}
+
+// 临时变量的活跃性，另加 64 个全局变量，每块使用一个、约 10% 的块写一个。
+// 全集随块数线性增长，而每个集合只有少数元素，是稀疏位集的场景
+Spec liveTemps(const Synthetic &f, std::mt19937 &rng) {
+    const size_t globals = 64;
+    int n = f.blocks();
+    size_t temps = 2 * (size_t)n;
+    Spec s = makeSpec("live_temps", FlowDirection::Backward, FlowMeet::Union, temps + globals, n);
+    std::uniform_int_distribution<size_t> pick(0, globals - 1);
+    for (size_t b = 0; b < (size_t)n; ++b) {
+        s.gen[b] = f.tempUses[b];
+        s.gen[b].push_back(temps + pick(rng));
+        s.kill[b] = {2 * b, 2 * b + 1};
+        if (pick(rng) < globals / 10) s.kill[b].push_back(temps + pick(rng));
+    }
+    return s;
+}
+
+template <class Set>
+FlowProblem<Set> build(const Spec &s) {
+    FlowProblem<Set> p(s.direction, s.meet, s.universe, (int)s.gen.size());
+    for (size_t b = 0; b < s.gen.size(); ++b) {
+        for (size_t e : s.gen[b]) p.gen[b].set(e);
+        for (size_t e : s.kill[b]) p.kill[b].set(e);
+    }
+    return p;
+}
+
+// 求解一次，输出一行 CSV；每块 in 集合的大小存入 sizes，供两种位集互相核对
+template <class Set>
+void run(int n, const FlowGraph &g, const Spec &s, const char *setName, std::vector<size_t> &sizes) {
+    FlowProblem<Set> p = build<Set>(s);
+    auto t0 = std::chrono::steady_clock::now();
+    FlowResult<Set> r = solveDataflow(g, p);
+    auto t1 = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    sizes.clear();
+    for (auto &in : r.in) sizes.push_back(in.count());
+    std::cout << n << "," << s.name << "," << setName << "," << s.universe << ","
+              << r.visits << "," << ms << "\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    // 用法：dataflow_bench [blocks ...]，默认约 10000 30000 100000 块。
+    // 输出 CSV：块数、问题、位集、全集大小、重算块次数、求解耗时。
+    // 稠密位集占用超过 512MB 的组合跳过；同一问题两种位集的结果不一致时返回 1
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) sizes.push_back(std::stoi(argv[i]));
+    if (sizes.empty()) sizes = {10000, 30000, 100000};
+    const double denseLimitMb = 512;
+
+    std::cout << "blocks,problem,set,universe,visits,ms\n";
+    bool mismatch = false;
+    for (int target : sizes) {
+        std::mt19937 rng((unsigned)target);
+        Synthetic f(target, rng);
+        const FlowGraph &g = f.graph;
+        int n = f.blocks();
+        for (const Spec &s : {liveVars(n, rng), availExprs(n, rng), liveTemps(f, rng)}) {
+            std::vector<size_t> dense, sparse;
+            // in、out、gen、kill 四组稠密位集
+            double denseMb = 4.0 * n * ((double)s.universe / 8) / (1024 * 1024);
+            if (denseMb <= denseLimitMb) run<DenseBitSet>(n, g, s, "dense", dense);
+            // 交集问题要从全集出发，稀疏位集不合适
+            if (s.meet == FlowMeet::Union) run<SparseBitSet>(n, g, s, "sparse", sparse);
+            if (!dense.empty() && !sparse.empty() && dense != sparse) {
+                std::cerr << "dense and sparse results differ: " << s.name << ", " << n << " blocks\n";
+                mismatch = true;
+            }
+        }
+    }
+    return mismatch ? 1 : 0;
+}
@@ -0,0 +1,23 @@
+// Diagnostics.cpp
+#include "Diagnostics.h"
+
+void Diagnostics::report(int line, ErrorCode code) {
+    if (line < 1) line = 1;
+    if ((size_t)line > buckets.size()) buckets.resize((size_t)line);
+    // 同一行内按类别码有序插入，一行通常只有一两个错误
+    auto &b = buckets[(size_t)line - 1];
+    auto it = b.end();
+    while (it != b.begin() && *(it - 1) > code) --it;
+    b.insert(it, code);
+    ++count;
+}
+
+void Diagnostics::write(std::ostream &os) const {
+    size_t written = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        for (ErrorCode c : buckets[i]) {
+            os << (i + 1) << " " << errorCodeChar(c);
+            if (++written != count) os << "\n";
+        }
+    }
+}
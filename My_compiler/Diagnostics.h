@@ -0,0 +1,40 @@
+#pragma once
+#include <ostream>
+#include <vector>
+#include <cstddef>
+
+// 错误类别（按文法说明中的错误类别码 a ~ m）
+enum class ErrorCode : unsigned char {
+    IllegalSymbol = 'a',   // 非法符号 & 或 |
+    Redefined,             // b 名字重定义
+    Undefined,             // c 未定义的名字
+    ArgCountMismatch,      // d 函数参数个数不匹配
+    ArgTypeMismatch,       // e 函数参数类型不匹配
+    ReturnInVoid,          // f 无返回值的函数存在不匹配的 return 语句
+    MissingReturn,         // g 有返回值的函数缺少 return 语句
+    AssignToConst,         // h 不能改变常量的值
+    MissingSemicn,         // i 缺少分号
+    MissingRparent,        // j 缺少右小括号 ')'
+    MissingRbrack,         // k 缺少右中括号 ']'
+    PrintfArgMismatch,     // l printf 中格式字符与表达式个数不匹配
+    BreakOutsideLoop       // m 在非循环块中使用 break 和 continue
+};
+
+inline char errorCodeChar(ErrorCode c) { return (char)c; }
+
+// 各阶段共用的错误收集器：按行分桶存放，输出时顺序遍历即可，无需排序
+class Diagnostics {
+public:
+    Diagnostics() : count(0) {}
+
+    void report(int line, ErrorCode code);
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    // 每行一条 "行号 类别码"，最后一行不带换行
+    void write(std::ostream &os) const;
+
+private:
+    std::vector<std::vector<ErrorCode>> buckets; // buckets[line - 1]
+    size_t count;
+};
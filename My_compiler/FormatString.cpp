@@ -0,0 +1,51 @@
+// FormatString.cpp
+#include "FormatString.h"
+
+int StringPool::intern(const std::string &text) {
+    auto it = ids.find(text);
+    if (it != ids.end()) return it->second;
+    int id = (int)strings.size();
+    strings.push_back(text);
+    ids.emplace(text, id);
+    return id;
+}
+
+void StringPool::emitData(std::ostream &os) const {
+    for (size_t i = 0; i < strings.size(); ++i) {
+        os << labelOf((int)i) << ": .asciiz \"" << strings[i] << "\"\n";
+    }
+}
+
+FormatString splitFormat(const std::string &strcon, StringPool &pool) {
+    FormatString fs;
+    size_t begin = 0, end = strcon.size();
+    if (end >= 2 && strcon.front() == '"' && strcon.back() == '"') { begin = 1; end -= 1; }
+
+    // 只在 %d 处切开，两个槽之间的文字天然是一整段，空段不产生打印
+    std::string seg;
+    auto flush = [&]() {
+        if (!seg.empty()) {
+            fs.pieces.push_back(FormatPiece{false, pool.intern(seg)});
+            seg.clear();
+        }
+    };
+    for (size_t i = begin; i < end; ++i) {
+        char c = strcon[i];
+        if (c == '%' && i + 1 < end && strcon[i+1] == 'd') {
+            flush();
+            fs.pieces.push_back(FormatPiece{true, -1});
+            ++fs.slotCount;
+            ++i;
+            continue;
+        }
+        if (c == '\\' && i + 1 < end) {
+            // 转义整体保留，避免把 \ 后面的字符当作格式符
+            seg.push_back(c);
+            seg.push_back(strcon[++i]);
+            continue;
+        }
+        seg.push_back(c);
+    }
+    flush();
+    return fs;
+}
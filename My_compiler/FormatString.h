@@ -0,0 +1,36 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <ostream>
+#include <unordered_map>
+
+// 全程序共享的字符串常量池：内容相同的段只保留一份 .asciiz
+class StringPool {
+public:
+    int intern(const std::string &text);
+    const std::string &text(int id) const { return strings[(size_t)id]; }
+    size_t size() const { return strings.size(); }
+
+    static std::string labelOf(int id) { return "str_" + std::to_string(id); }
+    // 输出 .data 段中的全部字符串常量
+    void emitData(std::ostream &os) const;
+
+private:
+    std::unordered_map<std::string, int> ids;
+    std::vector<std::string> strings;
+};
+
+// printf 格式串在编译期拆开后的结果：常量段与 %d 槽交替出现，
+// 每个常量段对应一次打印字符串的 syscall，每个槽对应一次打印整数
+struct FormatPiece {
+    bool isSlot;
+    int stringId;   // 常量段在 StringPool 中的编号，槽为 -1
+};
+
+struct FormatString {
+    std::vector<FormatPiece> pieces;
+    int slotCount = 0;   // %d 个数，与实参个数不一致时报错误 l
+};
+
+// strcon 为 STRCON 记号的原样字符串（含两侧双引号），转义保持源码写法，.asciiz 可直接使用
+FormatString splitFormat(const std::string &strcon, StringPool &pool);
@@ -1,19 +1,11 @@
 // Lexer.cpp
 #include "Lexer.h"
 #include <cctype>
-#include <iostream>
-#include <algorithm>
-
-Lexer::Lexer(const std::string &inputFile) : pos(0), line(1) {
-    // 读整个文件
-    std::ifstream ifs(inputFile);
-    if (!ifs) {
-        std::cerr << "Cannot open input file: " << inputFile << "\n";
-        exit(1);
-    }
-    input.assign((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+#include <cstdio>
+
+Lexer::Lexer(const std::string &inputFile, Diagnostics &diag)
+    : source(inputFile), input(source.buffer()), pos(0), diag(diag) {
     initKeywords();
-    initDefaultErrorMap();
 }
 
 void Lexer::initKeywords() {
@@ -33,25 +25,13 @@ void Lexer::initKeywords() {
     };
 }
 
-void Lexer::initDefaultErrorMap() {
-    // 词法分析阶段唯一的错误类型：非法符号 & 或 |
-    errorCodeMap["single&"] = "a";
-    errorCodeMap["single|"] = "a";
-}
-
-void Lexer::setErrorCodeFor(const std::string &key, const std::string &code) {
-    errorCodeMap[key] = code;
-}
-
 char Lexer::peek() const {
     if (pos >= input.size()) return '\0';
     return input[pos];
 }
 char Lexer::get() {
     if (pos >= input.size()) return '\0';
-    char c = input[pos++];
-    if (c == '\n') ++line;
-    return c;
+    return input[pos++];
 }
 bool Lexer::eof() const { return pos >= input.size(); }
 
@@ -85,46 +65,50 @@ void Lexer::skipWhitespaceAndComments() {
     }
 }
 
-void Lexer::tokenize() {
-    while (!eof()) {
-        skipWhitespaceAndComments();
-        if (eof()) break;
-        char c = peek();
-        if (std::isalpha((unsigned char)c) || c == '_') {
-            readIdentifierOrKeyword();
-        } else if (std::isdigit((unsigned char)c)) {
-            readNumber();
-        } else if (c == '"') {
-            readString();
-        } else {
-            readOperatorOrDelimiter();
-        }
+bool Lexer::next(Token &tok) {
+    skipWhitespaceAndComments();
+    if (eof()) return false;
+    char c = peek();
+    if (std::isalpha((unsigned char)c) || c == '_') {
+        readIdentifierOrKeyword();
+    } else if (std::isdigit((unsigned char)c)) {
+        readNumber();
+    } else if (c == '"') {
+        readString();
+    } else {
+        readOperatorOrDelimiter();
     }
+    tok = std::move(current);
+    return true;
+}
+
+void Lexer::emit(TokenType t, const std::string &s, size_t offset, int symbol) {
+    current = Token(t, s, offset, symbol);
 }
 
 void Lexer::readIdentifierOrKeyword() {
-    int startLine = line;
+    size_t start = pos;
     std::string s;
     while (!eof() && (std::isalnum((unsigned char)peek()) || peek() == '_')) {
         s.push_back(get());
     }
     auto it = keywords.find(s);
     if (it != keywords.end()) {
-        tokens.emplace_back(it->second, s, startLine);
+        emit(it->second, s, start);
     } else {
-        tokens.emplace_back(TokenType::IDENFR, s, startLine);
+        emit(TokenType::IDENFR, s, start, names.intern(s));
     }
 }
 
 void Lexer::readNumber() {
-    int startLine = line;
+    size_t start = pos;
     std::string s;
     while (!eof() && std::isdigit((unsigned char)peek())) s.push_back(get());
-    tokens.emplace_back(TokenType::INTCON, s, startLine);
+    emit(TokenType::INTCON, s, start);
 }
 
 void Lexer::readString() {
-    int startLine = line;
+    size_t start = pos;
     std::string s;
     s.push_back(get()); // consume opening "
     bool closed = false;
@@ -140,59 +124,59 @@ void Lexer::readString() {
     }
     if (!closed) {
         // 字符串未闭合错误，按题目要求，词法阶段不处理 → 可忽略
-        tokens.emplace_back(TokenType::STRCON, s, startLine);
+        emit(TokenType::STRCON, s, start);
     } else {
-        tokens.emplace_back(TokenType::STRCON, s, startLine);
+        emit(TokenType::STRCON, s, start);
     }
 }
 
 void Lexer::readOperatorOrDelimiter() {
-    int startLine = line;
+    size_t start = pos;
     char c = peek();
 
     // 特殊处理 & 和 |
     if (c == '&') {
         get();
         if (peek() == '&') {
-            get(); tokens.emplace_back(TokenType::AND, "&&", startLine);
+            get(); emit(TokenType::AND, "&&", start);
         } else {
-            recordError(startLine, errorCodeMap["single&"]);
-            tokens.emplace_back(TokenType::UNKNOWN, "&", startLine);
+            recordError(start, ErrorCode::IllegalSymbol);
+            emit(TokenType::UNKNOWN, "&", start);
         }
         return;
     }
     if (c == '|') {
         get();
         if (peek() == '|') {
-            get(); tokens.emplace_back(TokenType::OR, "||", startLine);
+            get(); emit(TokenType::OR, "||", start);
         } else {
-            recordError(startLine, errorCodeMap["single|"]);
-            tokens.emplace_back(TokenType::UNKNOWN, "|", startLine);
+            recordError(start, ErrorCode::IllegalSymbol);
+            emit(TokenType::UNKNOWN, "|", start);
         }
         return;
     }
     if (c == '=') {
         get();
-        if (peek() == '=') { get(); tokens.emplace_back(TokenType::EQL, "==", startLine); }
-        else { tokens.emplace_back(TokenType::ASSIGN, "=", startLine); }
+        if (peek() == '=') { get(); emit(TokenType::EQL, "==", start); }
+        else { emit(TokenType::ASSIGN, "=", start); }
         return;
     }
     if (c == '!') {
         get();
-        if (peek() == '=') { get(); tokens.emplace_back(TokenType::NEQ, "!=", startLine); }
-        else { tokens.emplace_back(TokenType::NOT, "!", startLine); }
+        if (peek() == '=') { get(); emit(TokenType::NEQ, "!=", start); }
+        else { emit(TokenType::NOT, "!", start); }
         return;
     }
     if (c == '<') {
         get();
-        if (peek() == '=') { get(); tokens.emplace_back(TokenType::LEQ, "<=", startLine); }
-        else { tokens.emplace_back(TokenType::LSS, "<", startLine); }
+        if (peek() == '=') { get(); emit(TokenType::LEQ, "<=", start); }
+        else { emit(TokenType::LSS, "<", start); }
         return;
     }
     if (c == '>') {
         get();
-        if (peek() == '=') { get(); tokens.emplace_back(TokenType::GEQ, ">=", startLine); }
-        else { tokens.emplace_back(TokenType::GRE, ">", startLine); }
+        if (peek() == '=') { get(); emit(TokenType::GEQ, ">=", start); }
+        else { emit(TokenType::GRE, ">", start); }
         return;
     }
 
@@ -200,48 +184,52 @@ void Lexer::readOperatorOrDelimiter() {
     get();
     std::string s(1, c);
     switch (c) {
-        case '+': tokens.emplace_back(TokenType::PLUS, s, startLine); return;
-        case '-': tokens.emplace_back(TokenType::MINU, s, startLine); return;
-        case '*': tokens.emplace_back(TokenType::MULT, s, startLine); return;
-        case '/': tokens.emplace_back(TokenType::DIV, s, startLine); return;
-        case '%': tokens.emplace_back(TokenType::MOD, s, startLine); return;
-        case ';': tokens.emplace_back(TokenType::SEMICN, s, startLine); return;
-        case ',': tokens.emplace_back(TokenType::COMMA, s, startLine); return;
-        case '(': tokens.emplace_back(TokenType::LPARENT, s, startLine); return;
-        case ')': tokens.emplace_back(TokenType::RPARENT, s, startLine); return;
-        case '[': tokens.emplace_back(TokenType::LBRACK, s, startLine); return;
-        case ']': tokens.emplace_back(TokenType::RBRACK, s, startLine); return;
-        case '{': tokens.emplace_back(TokenType::LBRACE, s, startLine); return;
-        case '}': tokens.emplace_back(TokenType::RBRACE, s, startLine); return;
+        case '+': emit(TokenType::PLUS, s, start); return;
+        case '-': emit(TokenType::MINU, s, start); return;
+        case '*': emit(TokenType::MULT, s, start); return;
+        case '/': emit(TokenType::DIV, s, start); return;
+        case '%': emit(TokenType::MOD, s, start); return;
+        case ';': emit(TokenType::SEMICN, s, start); return;
+        case ',': emit(TokenType::COMMA, s, start); return;
+        case '(': emit(TokenType::LPARENT, s, start); return;
+        case ')': emit(TokenType::RPARENT, s, start); return;
+        case '[': emit(TokenType::LBRACK, s, start); return;
+        case ']': emit(TokenType::RBRACK, s, start); return;
+        case '{': emit(TokenType::LBRACE, s, start); return;
+        case '}': emit(TokenType::RBRACE, s, start); return;
         default:
             // 其他非法字符 → 词法阶段忽略错误，不记录
-            tokens.emplace_back(TokenType::UNKNOWN, s, startLine);
+            emit(TokenType::UNKNOWN, s, start);
             return;
     }
 }
 
-void Lexer::recordError(int lineNo, const std::string &code) {
-    errors.emplace_back(lineNo, code);
+void Lexer::recordError(size_t offset, ErrorCode code) {
+    diag.report(source.lineOf(offset), code);
 }
 
-void Lexer::writeOutputs(const std::string &lexerFile, const std::string &errorFile) {
-    if (!errors.empty()) {
-        std::sort(errors.begin(), errors.end(), [](auto &a, auto &b){
-            if (a.first != b.first) return a.first < b.first;
-            return a.second < b.second;
-        });
-        std::ofstream ofs(errorFile);
-        for (size_t i = 0; i < errors.size(); ++i) {
-            ofs << errors[i].first << " " << errors[i].second;
-            if (i != errors.size() - 1) ofs << "\n";
-        }
-        ofs.close();
-    } else {
-        std::ofstream ofs(lexerFile);
-        for (size_t i = 0; i < tokens.size(); ++i) {
-            ofs << tokenTypeToString(tokens[i].type) << " " << tokens[i].lexeme;
-            if (i != tokens.size() - 1) ofs << "\n";
-        }
-        ofs.close();
+bool Lexer::streamTokens(std::ostream &os) {
+    // 一旦出现错误就不再写记号，只继续扫描收集错误
+    Token tok;
+    bool first = true;
+    while (next(tok)) {
+        if (!diag.empty()) continue;
+        if (!first) os << "\n";
+        os << tokenTypeToString(tok.type) << " " << tok.lexeme;
+        first = false;
+    }
+    return diag.empty();
+}
+
+void Lexer::streamOutputs(const std::string &lexerFile, const std::string &errorFile) {
+    // 边分析边写 lexer.txt，不保留整份记号表；有错误时删掉不完整的 lexer.txt
+    std::ofstream ofs(lexerFile);
+    bool ok = streamTokens(ofs);
+    ofs.close();
+    if (!ok) {
+        std::remove(lexerFile.c_str());
+        std::ofstream efs(errorFile);
+        diag.write(efs);
+        efs.close();
     }
 }
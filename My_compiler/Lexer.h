@@ -1,5 +1,8 @@
 #pragma once
 #include "Token.h"
+#include "SourceManager.h"
+#include "Diagnostics.h"
+#include "SymbolTable.h"
 #include <string>
 #include <vector>
 #include <fstream>
@@ -7,25 +10,32 @@
 
 class Lexer {
 public:
-    Lexer(const std::string &inputFile);
-    void tokenize(); // 执行词法分析
-    void writeOutputs(const std::string &lexerFile, const std::string &errorFile);
+    Lexer(const std::string &inputFile, Diagnostics &diag);
+    // input 引用的是自身 source 里的缓冲区，复制或移动后会指向原对象
+    Lexer(const Lexer &) = delete;
+    Lexer &operator=(const Lexer &) = delete;
+    Lexer(Lexer &&) = delete;
+    Lexer &operator=(Lexer &&) = delete;
+    bool next(Token &tok); // 取下一个记号，到文件尾返回 false
+    // 逐个记号写出 lexer.txt，内存占用与记号数无关；有错误时只输出 error.txt
+    void streamOutputs(const std::string &lexerFile, const std::string &errorFile);
+    // 把记号逐个写到 os，无词法错误时返回 true；有错误时 os 中内容不完整
+    bool streamTokens(std::ostream &os);
 
-    // 修改错误码映射（若你有完整映射可在外部设置）
-    void setErrorCodeFor(const std::string &key, const std::string &code);
+    const SourceManager &sourceManager() const { return source; }
+    const Interner &identifiers() const { return names; }
 
 private:
-    std::string input;
+    SourceManager source;
+    const std::string &input;
     size_t pos;
-    int line;
-    std::vector<Token> tokens;
-    std::vector<std::pair<int,std::string>> errors; // (line, errorCode)
+    Token current;     // read* 系列刚识别出的记号
+    Diagnostics &diag;
+    Interner names;
 
     std::unordered_map<std::string, TokenType> keywords;
-    std::unordered_map<std::string, std::string> errorCodeMap;
 
     void initKeywords();
-    void initDefaultErrorMap();
 
     char peek() const;
     char get();
@@ -36,5 +46,6 @@ private:
     void readNumber();
     void readString();
     void readOperatorOrDelimiter();
-    void recordError(int lineNo, const std::string &code);
+    void emit(TokenType t, const std::string &s, size_t offset, int symbol = -1);
+    void recordError(size_t offset, ErrorCode code);
 };
@@ -0,0 +1,89 @@
+#include "SysyGen.h"
+#include "Lexer.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+long peakRssKb() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024;
+#else
+    return ru.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
+// 把程序词法分析一遍，返回耗时（毫秒）
+double lexOnce(const std::string &file, size_t &tokens) {
+    auto t0 = std::chrono::steady_clock::now();
+    Diagnostics diag;
+    Lexer lexer(file, diag);
+    Token tok;
+    tokens = 0;
+    while (lexer.next(tok)) ++tokens;
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    // 用法：lexer_bench [steps] [repeats]
+    // 函数个数从 16 开始逐级翻倍，每个规模重复 repeats 次取中位数，
+    // 输出 CSV：字节数、记号数、耗时、每字节耗时、峰值内存。
+    // 规模递增，所以进程级的峰值内存近似等于当前规模的峰值
+    int steps = argc >= 2 ? std::stoi(argv[1]) : 8;
+    int repeats = std::max(1, argc >= 3 ? std::stoi(argv[2]) : 5);
+    // 小输入的耗时主要是固定开销和计时抖动，只比较不小于该规模的结果
+    const size_t minCompareBytes = 128 * 1024;
+    // 临时文件名带随机后缀，并行跑多个实例互不干扰
+    std::random_device rd;
+    const std::string tmp = (std::filesystem::temp_directory_path()
+        / ("lexer_bench_" + std::to_string(rd()) + ".txt")).string();
+    std::cout << "bytes,tokens,ms,ns_per_byte,peak_kb\n";
+    double first = 0, last = 0;
+    for (int k = 0; k < steps; ++k) {
+        GenConfig cfg;
+        cfg.seed = 1u + (unsigned)k;
+        cfg.functions = 16 << k;
+        std::string program = generateProgram(cfg);
+        {
+            std::ofstream ofs(tmp);
+            ofs << program;
+        }
+
+        size_t tokens = 0;
+        std::vector<double> samples;
+        for (int r = 0; r < repeats; ++r) samples.push_back(lexOnce(tmp, tokens));
+        std::nth_element(samples.begin(), samples.begin() + repeats / 2, samples.end());
+        double ms = samples[(size_t)repeats / 2];
+        double nsPerByte = ms * 1e6 / (double)program.size();
+        if (program.size() >= minCompareBytes) {
+            if (first == 0) first = nsPerByte;
+            last = nsPerByte;
+        }
+        std::cout << program.size() << "," << tokens << "," << ms << "," << nsPerByte << "," << peakRssKb() << "\n";
+    }
+    std::error_code ec;
+    std::filesystem::remove(tmp, ec);
+    // 每字节耗时明显上升说明存在超线性的环节
+    if (first > 0 && last > first * 2) {
+        std::cerr << "warning: time per byte grew from " << first << " ns to " << last << " ns\n";
+        return 2;
+    }
+    return 0;
+}
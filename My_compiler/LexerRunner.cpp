@@ -0,0 +1,177 @@
+#include "Lexer.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <map>
+
+namespace fs = std::filesystem;
+
+// 在进程内并行跑全部词法测试用例：每个目录含 testfile.txt、ans.txt、config.json，
+// 按 config.json 中的评分规则给分，并报告每个用例的耗时
+
+namespace {
+
+struct Case {
+    fs::path dir;
+    std::string name;    // 相对测试库根目录的路径
+    std::map<std::string, std::string> config;
+    int score = 0;
+    int badLines = 0;
+    double ms = 0;
+};
+
+bool readFile(const fs::path &p, std::string &out) {
+    std::ifstream ifs(p, std::ios::binary);
+    if (!ifs) return false;
+    out.assign((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// config.json 只是一层字符串键值，按 "键":"值" 逐对读取即可
+std::map<std::string, std::string> parseFlatJson(const std::string &text) {
+    std::map<std::string, std::string> kv;
+    auto readString = [&](size_t &i, std::string &s) {
+        i = text.find('"', i);
+        if (i == std::string::npos) return false;
+        s.clear();
+        for (++i; i < text.size() && text[i] != '"'; ++i) {
+            if (text[i] == '\\' && i + 1 < text.size()) ++i;
+            s.push_back(text[i]);
+        }
+        ++i;
+        return i <= text.size();
+    };
+    size_t i = 0;
+    std::string key, value;
+    while (readString(i, key)) {
+        size_t colon = text.find(':', i);
+        if (colon == std::string::npos) break;
+        i = colon + 1;
+        if (!readString(i, value)) break;
+        kv[key] = value;
+    }
+    return kv;
+}
+
+std::vector<std::string> splitLines(const std::string &text) {
+    std::vector<std::string> lines;
+    std::string cur;
+    for (char c : text) {
+        if (c == '\r') continue;
+        if (c == '\n') { lines.push_back(cur); cur.clear(); }
+        else cur.push_back(c);
+    }
+    if (!cur.empty()) lines.push_back(cur);
+    while (!lines.empty() && lines.back().empty()) lines.pop_back();
+    return lines;
+}
+
+// 按最长公共子序列对齐后统计错行数，漏一行或多一行只算一处
+// 先去掉相同的首尾，通过的用例因此是线性的
+int diffLines(const std::vector<std::string> &a, const std::vector<std::string> &b) {
+    size_t lo = 0, ea = a.size(), eb = b.size();
+    while (lo < ea && lo < eb && a[lo] == b[lo]) ++lo;
+    while (ea > lo && eb > lo && a[ea-1] == b[eb-1]) { --ea; --eb; }
+    std::vector<int> prev(eb - lo + 1, 0), cur(eb - lo + 1, 0);
+    for (size_t i = lo; i < ea; ++i) {
+        for (size_t j = lo; j < eb; ++j) {
+            size_t k = j - lo + 1;
+            cur[k] = a[i] == b[j] ? prev[k-1] + 1 : std::max(prev[k], cur[k-1]);
+        }
+        std::swap(prev, cur);
+    }
+    return (int)(std::max(ea, eb) - lo) - prev[eb - lo];
+}
+
+void runCase(Case &c) {
+    auto t0 = std::chrono::steady_clock::now();
+    Diagnostics diag;
+    Lexer lexer((c.dir / "testfile.txt").string(), diag);
+    std::ostringstream os;
+    if (!lexer.streamTokens(os)) {
+        os.str("");
+        diag.write(os);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    c.ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+    std::string ans;
+    readFile(c.dir / "ans.txt", ans);
+    std::vector<std::string> got = splitLines(os.str()), want = splitLines(ans);
+    c.badLines = diffLines(got, want);
+
+    // deduct_per_line：每错一行扣 score_per_line 分；其他规则按全对才得分处理
+    const int full = 100;
+    if (c.config["score_rule"] == "deduct_per_line") {
+        int per = c.config.count("score_per_line") ? std::atoi(c.config["score_per_line"].c_str()) : 1;
+        c.score = std::max(0, full - per * c.badLines);
+    } else {
+        c.score = c.badLines == 0 ? full : 0;
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    // 用法：lexer_runner [测试库根目录 ...]，默认扫描当前目录
+    std::vector<fs::path> roots;
+    for (int i = 1; i < argc; ++i) roots.emplace_back(argv[i]);
+    if (roots.empty()) roots.emplace_back(".");
+
+    std::vector<Case> cases;
+    for (auto &root : roots) {
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+            if (!it->is_directory()) continue;
+            const fs::path &d = it->path();
+            if (!fs::exists(d / "config.json") || !fs::exists(d / "testfile.txt") || !fs::exists(d / "ans.txt")) continue;
+            std::string cfgText;
+            readFile(d / "config.json", cfgText);
+            Case c;
+            c.dir = d;
+            c.name = d.lexically_relative(root).generic_string();
+            c.config = parseFlatJson(cfgText);
+            if (c.config["type"] != "lexer") continue;
+            cases.push_back(c);
+        }
+    }
+    std::sort(cases.begin(), cases.end(), [](const Case &a, const Case &b){ return a.dir < b.dir; });
+    if (cases.empty()) {
+        std::cerr << "no lexer test cases found\n";
+        return 1;
+    }
+
+    // 线程从共享下标里领取用例，先做完的线程接着领，负载自然均衡
+    auto t0 = std::chrono::steady_clock::now();
+    std::atomic<size_t> nextCase(0);
+    unsigned workers = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned)cases.size()));
+    std::vector<std::thread> pool;
+    for (unsigned w = 0; w < workers; ++w) {
+        pool.emplace_back([&]() {
+            for (size_t i; (i = nextCase.fetch_add(1)) < cases.size(); ) runCase(cases[i]);
+        });
+    }
+    for (auto &t : pool) t.join();
+    auto t1 = std::chrono::steady_clock::now();
+
+    int failed = 0;
+    for (auto &c : cases) {
+        std::cout << std::left << std::setw(6) << (c.score == 100 ? "PASS" : "FAIL")
+                  << std::right << std::setw(4) << c.score << "  "
+                  << std::fixed << std::setprecision(3) << std::setw(8) << c.ms << " ms  "
+                  << c.name;
+        if (c.badLines) std::cout << "  (" << c.badLines << " lines differ)";
+        std::cout << "\n";
+        if (c.score != 100) ++failed;
+    }
+    std::cout << cases.size() - failed << "/" << cases.size() << " passed, "
+              << workers << " threads, "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms wall\n";
+    return failed ? 1 : 0;
+}
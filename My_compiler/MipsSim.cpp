@@ -0,0 +1,789 @@
+// MipsSim.cpp
+#include "MipsSim.h"
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <climits>
+
+namespace {
+
+const uint32_t TEXT_BASE = 0x00400000;
+const uint32_t DATA_BASE = 0x10010000;
+const uint32_t GP_INIT = 0x10008000;
+const uint32_t SP_INIT = 0x7fffeffc;
+const uint8_t AT = 1, V0 = 2, A0 = 4, RA = 31;
+
+int parseRegister(const std::string &s) {
+    static const std::unordered_map<std::string, int> names = {
+        {"zero", 0}, {"at", 1}, {"v0", 2}, {"v1", 3},
+        {"a0", 4}, {"a1", 5}, {"a2", 6}, {"a3", 7},
+        {"t0", 8}, {"t1", 9}, {"t2", 10}, {"t3", 11}, {"t4", 12}, {"t5", 13}, {"t6", 14}, {"t7", 15},
+        {"s0", 16}, {"s1", 17}, {"s2", 18}, {"s3", 19}, {"s4", 20}, {"s5", 21}, {"s6", 22}, {"s7", 23},
+        {"t8", 24}, {"t9", 25}, {"k0", 26}, {"k1", 27}, {"gp", 28}, {"sp", 29}, {"fp", 30}, {"s8", 30},
+        {"ra", 31}
+    };
+    if (s.size() < 2 || s[0] != '$') return -1;
+    std::string body = s.substr(1);
+    if (std::isdigit((unsigned char)body[0])) {
+        for (char c : body) if (!std::isdigit((unsigned char)c)) return -1;
+        int n = std::stoi(body);
+        return n < 32 ? n : -1;
+    }
+    auto it = names.find(body);
+    return it == names.end() ? -1 : it->second;
+}
+
+bool parseInteger(const std::string &s, int64_t &v) {
+    if (s.empty()) return false;
+    size_t i = 0;
+    bool neg = false;
+    if (s[i] == '-' || s[i] == '+') { neg = s[i] == '-'; ++i; }
+    if (i >= s.size()) return false;
+    if (s[i] == '\'' && s.size() >= i + 3 && s.back() == '\'') {
+        std::string body = s.substr(i + 1, s.size() - i - 2);
+        if (body.size() == 1) v = (unsigned char)body[0];
+        else if (body == "\\n") v = '\n';
+        else if (body == "\\t") v = '\t';
+        else if (body == "\\0") v = 0;
+        else if (body == "\\\\") v = '\\';
+        else return false;
+        if (neg) v = -v;
+        return true;
+    }
+    int base = 10;
+    if (s.size() > i + 2 && s[i] == '0' && (s[i+1] == 'x' || s[i+1] == 'X')) { base = 16; i += 2; }
+    int64_t r = 0;
+    for (; i < s.size(); ++i) {
+        int d;
+        char c = s[i];
+        if (std::isdigit((unsigned char)c)) d = c - '0';
+        else if (base == 16 && std::isxdigit((unsigned char)c)) d = std::tolower((unsigned char)c) - 'a' + 10;
+        else return false;
+        r = r * base + d;
+        if (r > 0xffffffffLL) return false;
+    }
+    v = neg ? -r : r;
+    return true;
+}
+
+bool fitsSigned16(int64_t v) { return v >= -32768 && v <= 32767; }
+
+// 去掉 # 注释（字符串内的 # 保留）
+std::string stripComment(const std::string &line) {
+    bool inStr = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (inStr && c == '\\') { ++i; continue; }
+        if (c == '"') inStr = !inStr;
+        if (c == '#' && !inStr) return line.substr(0, i);
+    }
+    return line;
+}
+
+std::string trim(const std::string &s) {
+    size_t b = 0, e = s.size();
+    while (b < e && std::isspace((unsigned char)s[b])) ++b;
+    while (e > b && std::isspace((unsigned char)s[e-1])) --e;
+    return s.substr(b, e - b);
+}
+
+// 操作数按逗号和空白切分；"4 ($sp)" 这类写法把括号部分并回前一个
+std::vector<std::string> splitOperands(const std::string &s) {
+    std::vector<std::string> ops;
+    std::string cur;
+    for (char c : s) {
+        if (c == ',' || std::isspace((unsigned char)c)) {
+            if (!cur.empty()) { ops.push_back(cur); cur.clear(); }
+        } else {
+            cur.push_back(c);
+        }
+    }
+    if (!cur.empty()) ops.push_back(cur);
+    std::vector<std::string> merged;
+    for (auto &o : ops) {
+        if (!merged.empty() && o[0] == '(') merged.back() += o;
+        else merged.push_back(o);
+    }
+    return merged;
+}
+
+bool parseStringLiteral(const std::string &s, std::string &out) {
+    std::string t = trim(s);
+    if (t.size() < 2 || t.front() != '"' || t.back() != '"') return false;
+    out.clear();
+    for (size_t i = 1; i + 1 < t.size(); ++i) {
+        char c = t[i];
+        if (c == '\\' && i + 2 < t.size()) {
+            char n = t[++i];
+            switch (n) {
+                case 'n': out.push_back('\n'); break;
+                case 't': out.push_back('\t'); break;
+                case '0': out.push_back('\0'); break;
+                case '"': out.push_back('"'); break;
+                case '\\': out.push_back('\\'); break;
+                default: out.push_back('\\'); out.push_back(n); break;
+            }
+        } else {
+            out.push_back(c);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+const char *instClassName(InstClass c) {
+    switch (c) {
+        case InstClass::Alu: return "alu";
+        case InstClass::Mult: return "mult";
+        case InstClass::Div: return "div";
+        case InstClass::Load: return "load";
+        case InstClass::Store: return "store";
+        case InstClass::Branch: return "branch";
+        case InstClass::Jump: return "jump";
+        case InstClass::Syscall: return "syscall";
+        default: return "?";
+    }
+}
+
+double SimStats::weightedCost() const {
+    auto n = [this](InstClass c) { return (double)byClass[(size_t)c]; };
+    return n(InstClass::Div) * 50 + n(InstClass::Mult) * 3
+         + (n(InstClass::Branch) + n(InstClass::Jump)) * 1.2
+         + (n(InstClass::Load) + n(InstClass::Store)) * 2
+         + n(InstClass::Alu) + n(InstClass::Syscall);
+}
+
+MipsSim::MipsSim(const SimConfig &cfg) : cfg(cfg) {}
+
+InstClass MipsSim::classOf(Op op) {
+    switch (op) {
+        case Op::MUL: case Op::MULT: case Op::MULTU: return InstClass::Mult;
+        case Op::DIV: case Op::DIVU: return InstClass::Div;
+        case Op::LW: case Op::LH: case Op::LHU: case Op::LB: case Op::LBU: return InstClass::Load;
+        case Op::SW: case Op::SH: case Op::SB: return InstClass::Store;
+        case Op::BEQ: case Op::BNE: case Op::BLEZ: case Op::BGTZ: case Op::BLTZ: case Op::BGEZ:
+            return InstClass::Branch;
+        case Op::J: case Op::JAL: case Op::JR: case Op::JALR: return InstClass::Jump;
+        case Op::SYSCALL: return InstClass::Syscall;
+        default: return InstClass::Alu;
+    }
+}
+
+bool MipsSim::fail(int line, const std::string &msg) {
+    std::ostringstream os;
+    if (line > 0) os << "line " << line << ": ";
+    os << msg;
+    err = os.str();
+    return false;
+}
+
+bool MipsSim::load(const std::string &asmText) {
+    // 第一遍只为确定标签地址，第二遍生成指令和数据
+    labels.clear();
+    err.clear();
+    return assemble(asmText, false) && assemble(asmText, true);
+}
+
+bool MipsSim::assemble(const std::string &src, bool resolve) {
+    text.clear();
+    data.clear();
+    std::vector<std::pair<size_t, std::string>> textLabels;
+    bool inText = true;
+    std::istringstream is(src);
+    std::string raw;
+    int lineNo = 0;
+    // 标签先挂起，等看到下一条指令或伪指令、做完对齐后再定地址（与 MARS 一致）
+    std::vector<std::pair<std::string, int>> pending;
+    auto bindPending = [&]() {
+        for (auto &pl : pending) {
+            uint32_t addr = inText ? TEXT_BASE + 4 * (uint32_t)text.size() : DATA_BASE + (uint32_t)data.size();
+            if (!resolve) {
+                if (labels.count(pl.first)) return fail(pl.second, "duplicate label '" + pl.first + "'");
+                labels[pl.first] = addr;
+            } else if (inText) {
+                textLabels.emplace_back(text.size(), pl.first);
+            }
+        }
+        pending.clear();
+        return true;
+    };
+    while (std::getline(is, raw)) {
+        ++lineNo;
+        std::string line = trim(stripComment(raw));
+        // 行首的若干个标签
+        while (!line.empty()) {
+            size_t i = 0;
+            while (i < line.size() && (std::isalnum((unsigned char)line[i]) || line[i] == '_' || line[i] == '.' || line[i] == '$')) ++i;
+            if (i == 0 || i >= line.size() || line[i] != ':') break;
+            pending.emplace_back(line.substr(0, i), lineNo);
+            line = trim(line.substr(i + 1));
+        }
+        if (line.empty()) continue;
+
+        size_t sp = 0;
+        while (sp < line.size() && !std::isspace((unsigned char)line[sp])) ++sp;
+        std::string head = line.substr(0, sp);
+        std::string rest = trim(line.substr(sp));
+        std::transform(head.begin(), head.end(), head.begin(), [](unsigned char c){ return (char)std::tolower(c); });
+
+        if (head[0] == '.') {
+            if (head == ".data" || head == ".text") {
+                if (!bindPending()) return false;
+                inText = head == ".text";
+                continue;
+            }
+            if (head == ".globl" || head == ".global" || head == ".extern") continue;
+            if (inText) return fail(lineNo, "data directive '" + head + "' in .text");
+            // .word/.half 自动按宽度对齐，标签指向对齐后的地址
+            int align = head == ".word" ? 4 : head == ".half" ? 2 : 1;
+            data.resize((data.size() + align - 1) / align * align, 0);
+            if (!bindPending()) return false;
+            if (head == ".asciiz" || head == ".ascii") {
+                std::string s;
+                if (!parseStringLiteral(rest, s)) return fail(lineNo, "bad string literal");
+                data.insert(data.end(), s.begin(), s.end());
+                if (head == ".asciiz") data.push_back(0);
+                continue;
+            }
+            if (head == ".space") {
+                int64_t n;
+                if (!parseInteger(rest, n) || n < 0) return fail(lineNo, "bad .space size");
+                data.resize(data.size() + (size_t)n, 0);
+                continue;
+            }
+            if (head == ".align") {
+                int64_t n;
+                if (!parseInteger(rest, n) || n < 0 || n > 12) return fail(lineNo, "bad .align");
+                size_t a = (size_t)1 << n;
+                data.resize((data.size() + a - 1) / a * a, 0);
+                continue;
+            }
+            int width = head == ".word" ? 4 : head == ".half" ? 2 : head == ".byte" ? 1 : 0;
+            if (width == 0) return fail(lineNo, "unknown directive '" + head + "'");
+            for (auto &item : splitOperands(rest)) {
+                // MARS 的 "值:个数" 写法
+                std::string valText = item;
+                int64_t repeat = 1;
+                size_t colon = item.find(':');
+                if (colon != std::string::npos) {
+                    valText = item.substr(0, colon);
+                    if (!parseInteger(item.substr(colon + 1), repeat) || repeat < 0) return fail(lineNo, "bad repeat count");
+                }
+                int64_t v = 0;
+                if (!parseInteger(valText, v)) {
+                    if (!resolve) v = 0;
+                    else if (labels.count(valText)) v = labels[valText];
+                    else return fail(lineNo, "undefined label '" + valText + "'");
+                }
+                for (int64_t k = 0; k < repeat; ++k)
+                    for (int b = 0; b < width; ++b) data.push_back((uint8_t)((uint64_t)v >> (8 * b)));
+            }
+            continue;
+        }
+
+        if (!inText) return fail(lineNo, "instruction '" + head + "' in .data");
+        if (!bindPending()) return false;
+        if (!expand(head, splitOperands(rest), lineNo, resolve, text)) return false;
+    }
+    if (!bindPending()) return false;
+
+    if (resolve) {
+        // 函数划分：程序入口、main 以及所有 jal 目标
+        std::vector<bool> isEntry(text.size() + 1, false);
+        isEntry[0] = true;
+        for (auto &in : text) if (in.op == Op::JAL) isEntry[(size_t)in.imm] = true;
+        funcNames.clear();
+        funcOf.assign(text.size(), 0);
+        std::unordered_map<size_t, std::string> nameAt;
+        for (auto &tl : textLabels) {
+            if (tl.second == "main") isEntry[tl.first] = true;
+            if (!nameAt.count(tl.first)) nameAt[tl.first] = tl.second;
+        }
+        int cur = -1;
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (isEntry[i]) {
+                funcNames.push_back(nameAt.count(i) ? nameAt[i] : "<start>");
+                cur = (int)funcNames.size() - 1;
+            }
+            funcOf[i] = cur;
+        }
+    }
+    return true;
+}
+
+bool MipsSim::expand(const std::string &m, const std::vector<std::string> &ops,
+                     int line, bool resolve, std::vector<Inst> &out) {
+    auto emit = [&](Op op, int rd, int rs, int rt, int64_t imm) {
+        out.push_back(Inst{op, (uint8_t)rd, (uint8_t)rs, (uint8_t)rt, (int32_t)imm, line});
+    };
+    auto need = [&](size_t n) {
+        if (ops.size() != n) return fail(line, "'" + m + "' expects " + std::to_string(n) + " operands");
+        return true;
+    };
+    auto reg = [&](size_t i, int &r) {
+        r = parseRegister(ops[i]);
+        if (r < 0) return fail(line, "bad register '" + ops[i] + "'");
+        return true;
+    };
+    auto label = [&](const std::string &name, int64_t &addr) {
+        addr = 0;
+        if (!resolve) return true;
+        auto it = labels.find(name);
+        if (it == labels.end()) return fail(line, "undefined label '" + name + "'");
+        addr = it->second;
+        return true;
+    };
+    auto target = [&](size_t i, int64_t &idx) {
+        int64_t addr;
+        if (!label(ops[i], addr)) return false;
+        idx = resolve ? (addr - TEXT_BASE) / 4 : 0;
+        if (resolve && (addr < TEXT_BASE || addr % 4 != 0)) return fail(line, "'" + ops[i] + "' is not a text label");
+        return true;
+    };
+    // 把任意 32 位常数装入寄存器（li 的展开）
+    auto loadImm = [&](int rd, int64_t v) {
+        if (fitsSigned16(v)) emit(Op::ADDIU, rd, 0, 0, v);
+        else if (v >= 0 && v <= 0xffff) emit(Op::ORI, rd, 0, 0, v);
+        else {
+            uint32_t u = (uint32_t)v;
+            emit(Op::LUI, AT, 0, 0, u >> 16);
+            emit(Op::ORI, rd, AT, 0, u & 0xffff);
+        }
+    };
+    // 第二个源操作数可以是寄存器或立即数，立即数先装入 $at
+    auto regOrImm = [&](size_t i, int &r) {
+        int64_t v;
+        if (parseInteger(ops[i], v)) { loadImm(AT, v); r = AT; return true; }
+        return reg(i, r);
+    };
+    // 访存地址：off($r)、($r)、label、label+off、label($r)、绝对地址
+    auto memOperand = [&](Op op, int rt, const std::string &a) {
+        size_t lp = a.find('(');
+        std::string offText = lp == std::string::npos ? a : a.substr(0, lp);
+        int base = 0;
+        if (lp != std::string::npos) {
+            if (a.back() != ')') return fail(line, "bad address '" + a + "'");
+            base = parseRegister(a.substr(lp + 1, a.size() - lp - 2));
+            if (base < 0) return fail(line, "bad base register in '" + a + "'");
+        }
+        int64_t off = 0;
+        if (offText.empty() || parseInteger(offText, off)) {
+            if (fitsSigned16(off)) { emit(op, 0, base, rt, off); return true; }
+        } else {
+            std::string name = offText;
+            int64_t extra = 0;
+            size_t plus = offText.find_first_of("+-", 1);
+            if (plus != std::string::npos) {
+                name = offText.substr(0, plus);
+                if (!parseInteger(offText.substr(plus), extra)) return fail(line, "bad address '" + a + "'");
+            }
+            if (!label(name, off)) return false;
+            off += extra;
+        }
+        uint32_t u = (uint32_t)off;
+        emit(Op::LUI, AT, 0, 0, ((u + 0x8000) >> 16) & 0xffff);
+        if (base != 0) emit(Op::ADDU, AT, AT, base, 0);
+        emit(op, 0, AT, rt, (int16_t)(u & 0xffff));
+        return true;
+    };
+
+    static const std::unordered_map<std::string, Op> rType = {
+        {"add", Op::ADD}, {"addu", Op::ADDU}, {"sub", Op::SUB}, {"subu", Op::SUBU},
+        {"and", Op::AND}, {"or", Op::OR}, {"xor", Op::XOR}, {"nor", Op::NOR},
+        {"slt", Op::SLT}, {"sltu", Op::SLTU}, {"sllv", Op::SLLV}, {"srlv", Op::SRLV},
+        {"srav", Op::SRAV}, {"mul", Op::MUL}, {"movn", Op::MOVN}, {"movz", Op::MOVZ}
+    };
+    // R 型指令的立即数形式，第二项表示立即数是否零扩展
+    static const std::unordered_map<std::string, std::pair<Op, bool>> iForm = {
+        {"add", {Op::ADDI, false}}, {"addu", {Op::ADDIU, false}}, {"addi", {Op::ADDI, false}},
+        {"addiu", {Op::ADDIU, false}}, {"and", {Op::ANDI, true}}, {"andi", {Op::ANDI, true}},
+        {"or", {Op::ORI, true}}, {"ori", {Op::ORI, true}}, {"xor", {Op::XORI, true}},
+        {"xori", {Op::XORI, true}}, {"slt", {Op::SLTI, false}}, {"slti", {Op::SLTI, false}},
+        {"sltu", {Op::SLTIU, false}}, {"sltiu", {Op::SLTIU, false}}
+    };
+    static const std::unordered_map<std::string, Op> memOps = {
+        {"lw", Op::LW}, {"lh", Op::LH}, {"lhu", Op::LHU}, {"lb", Op::LB}, {"lbu", Op::LBU},
+        {"sw", Op::SW}, {"sh", Op::SH}, {"sb", Op::SB}
+    };
+
+    int rd, rs, rt;
+    int64_t v, t;
+
+    auto rit = rType.find(m);
+    auto iit = iForm.find(m);
+    if (rit != rType.end() || iit != iForm.end()) {
+        if (!need(3) || !reg(0, rd) || !reg(1, rs)) return false;
+        if (parseInteger(ops[2], v)) {
+            if (iit != iForm.end()) {
+                bool zext = iit->second.second;
+                bool fits = zext ? (v >= 0 && v <= 0xffff) : fitsSigned16(v);
+                if (fits) { emit(iit->second.first, rd, rs, 0, v); return true; }
+            }
+            Op rop = rit != rType.end() ? rit->second
+                   : m == "addi" ? Op::ADD : m == "addiu" ? Op::ADDU : m == "andi" ? Op::AND
+                   : m == "ori" ? Op::OR : m == "xori" ? Op::XOR : m == "slti" ? Op::SLT : Op::SLTU;
+            loadImm(AT, v);
+            emit(rop, rd, rs, AT, 0);
+            return true;
+        }
+        if (rit == rType.end()) return fail(line, "'" + m + "' expects an immediate");
+        if (!reg(2, rt)) return false;
+        emit(rit->second, rd, rs, rt, 0);
+        return true;
+    }
+
+    auto mit = memOps.find(m);
+    if (mit != memOps.end()) {
+        if (!need(2) || !reg(0, rt)) return false;
+        return memOperand(mit->second, rt, ops[1]);
+    }
+
+    if (m == "sll" || m == "srl" || m == "sra") {
+        if (!need(3) || !reg(0, rd) || !reg(1, rt)) return false;
+        if (!parseInteger(ops[2], v) || v < 0 || v > 31) return fail(line, "bad shift amount");
+        emit(m == "sll" ? Op::SLL : m == "srl" ? Op::SRL : Op::SRA, rd, 0, rt, v);
+        return true;
+    }
+    if (m == "subi" || m == "subiu") {
+        if (!need(3) || !reg(0, rd) || !reg(1, rs)) return false;
+        if (!parseInteger(ops[2], v)) return fail(line, "bad immediate");
+        if (fitsSigned16(-v)) emit(m == "subi" ? Op::ADDI : Op::ADDIU, rd, rs, 0, -v);
+        else { loadImm(AT, v); emit(m == "subi" ? Op::SUB : Op::SUBU, rd, rs, AT, 0); }
+        return true;
+    }
+    if (m == "lui") {
+        if (!need(2) || !reg(0, rt)) return false;
+        if (!parseInteger(ops[1], v) || v < 0 || v > 0xffff) return fail(line, "bad immediate");
+        emit(Op::LUI, rt, 0, 0, v);
+        return true;
+    }
+    if (m == "li") {
+        if (!need(2) || !reg(0, rd)) return false;
+        if (!parseInteger(ops[1], v)) return fail(line, "bad immediate");
+        loadImm(rd, v);
+        return true;
+    }
+    if (m == "la") {
+        if (!need(2) || !reg(0, rd)) return false;
+        size_t lp = ops[1].find('(');
+        if (lp != std::string::npos) {
+            // la $t, off($r) 即 addiu
+            const std::string &a = ops[1];
+            rs = a.back() == ')' ? parseRegister(a.substr(lp + 1, a.size() - lp - 2)) : -1;
+            v = 0;
+            if (rs < 0 || (lp > 0 && !parseInteger(a.substr(0, lp), v)) || !fitsSigned16(v))
+                return fail(line, "bad address '" + a + "'");
+            emit(Op::ADDIU, rd, rs, 0, v);
+            return true;
+        }
+        std::string name = ops[1];
+        int64_t extra = 0;
+        size_t plus = name.find_first_of("+-", 1);
+        if (plus != std::string::npos) {
+            if (!parseInteger(name.substr(plus), extra)) return fail(line, "bad address");
+            name = name.substr(0, plus);
+        }
+        if (!label(name, v)) return false;
+        uint32_t u = (uint32_t)(v + extra);
+        emit(Op::LUI, AT, 0, 0, u >> 16);
+        emit(Op::ORI, rd, AT, 0, u & 0xffff);
+        return true;
+    }
+    if (m == "move") {
+        if (!need(2) || !reg(0, rd) || !reg(1, rs)) return false;
+        emit(Op::ADDU, rd, 0, rs, 0);
+        return true;
+    }
+    if (m == "neg" || m == "negu" || m == "not") {
+        if (!need(2) || !reg(0, rd) || !reg(1, rs)) return false;
+        if (m == "not") emit(Op::NOR, rd, rs, 0, 0);
+        else emit(m == "neg" ? Op::SUB : Op::SUBU, rd, 0, rs, 0);
+        return true;
+    }
+    if (m == "mult" || m == "multu" || ((m == "div" || m == "divu") && ops.size() == 2)) {
+        if (!need(2) || !reg(0, rs) || !reg(1, rt)) return false;
+        emit(m == "mult" ? Op::MULT : m == "multu" ? Op::MULTU : m == "div" ? Op::DIV : Op::DIVU, 0, rs, rt, 0);
+        return true;
+    }
+    if (m == "div" || m == "divu" || m == "rem" || m == "remu") {
+        if (!need(3) || !reg(0, rd) || !reg(1, rs) || !regOrImm(2, rt)) return false;
+        emit(m == "div" || m == "rem" ? Op::DIV : Op::DIVU, 0, rs, rt, 0);
+        emit(m[0] == 'd' ? Op::MFLO : Op::MFHI, rd, 0, 0, 0);
+        return true;
+    }
+    if (m == "mfhi" || m == "mflo" || m == "mthi" || m == "mtlo") {
+        if (!need(1) || !reg(0, rd)) return false;
+        if (m == "mfhi") emit(Op::MFHI, rd, 0, 0, 0);
+        else if (m == "mflo") emit(Op::MFLO, rd, 0, 0, 0);
+        else emit(m == "mthi" ? Op::MTHI : Op::MTLO, 0, rd, 0, 0);
+        return true;
+    }
+    if (m == "seq" || m == "sne" || m == "sgt" || m == "sge" || m == "sle" || m == "sgtu" || m == "sgeu" || m == "sleu") {
+        if (!need(3) || !reg(0, rd) || !reg(1, rs) || !regOrImm(2, rt)) return false;
+        bool u = m.back() == 'u';
+        Op lt = u ? Op::SLTU : Op::SLT;
+        std::string base = u ? m.substr(0, 3) : m;
+        if (base == "seq") { emit(Op::SUBU, rd, rs, rt, 0); emit(Op::SLTIU, rd, rd, 0, 1); }
+        else if (base == "sne") { emit(Op::SUBU, rd, rs, rt, 0); emit(Op::SLTU, rd, 0, rd, 0); }
+        else if (base == "sgt") emit(lt, rd, rt, rs, 0);
+        else if (base == "sge") { emit(lt, rd, rs, rt, 0); emit(Op::XORI, rd, rd, 0, 1); }
+        else { emit(lt, rd, rt, rs, 0); emit(Op::XORI, rd, rd, 0, 1); }
+        return true;
+    }
+    if (m == "beq" || m == "bne") {
+        if (!need(3) || !reg(0, rs) || !regOrImm(1, rt) || !target(2, t)) return false;
+        emit(m == "beq" ? Op::BEQ : Op::BNE, 0, rs, rt, t);
+        return true;
+    }
+    if (m == "blt" || m == "bgt" || m == "ble" || m == "bge"
+        || m == "bltu" || m == "bgtu" || m == "bleu" || m == "bgeu") {
+        if (!need(3) || !reg(0, rs) || !regOrImm(1, rt) || !target(2, t)) return false;
+        Op lt = m.size() == 4 ? Op::SLTU : Op::SLT;
+        std::string base = m.substr(0, 3);
+        // blt/bge 比较 rs<rt，bgt/ble 比较 rt<rs
+        if (base == "blt" || base == "bge") emit(lt, AT, rs, rt, 0);
+        else emit(lt, AT, rt, rs, 0);
+        emit(base == "blt" || base == "bgt" ? Op::BNE : Op::BEQ, 0, AT, 0, t);
+        return true;
+    }
+    if (m == "beqz" || m == "bnez") {
+        if (!need(2) || !reg(0, rs) || !target(1, t)) return false;
+        emit(m == "beqz" ? Op::BEQ : Op::BNE, 0, rs, 0, t);
+        return true;
+    }
+    if (m == "blez" || m == "bgtz" || m == "bltz" || m == "bgez") {
+        if (!need(2) || !reg(0, rs) || !target(1, t)) return false;
+        emit(m == "blez" ? Op::BLEZ : m == "bgtz" ? Op::BGTZ : m == "bltz" ? Op::BLTZ : Op::BGEZ, 0, rs, 0, t);
+        return true;
+    }
+    if (m == "b" || m == "j" || m == "jal") {
+        if (!need(1) || !target(0, t)) return false;
+        if (m == "b") emit(Op::BEQ, 0, 0, 0, t);
+        else emit(m == "j" ? Op::J : Op::JAL, 0, 0, 0, t);
+        return true;
+    }
+    if (m == "jr") {
+        if (!need(1) || !reg(0, rs)) return false;
+        emit(Op::JR, 0, rs, 0, 0);
+        return true;
+    }
+    if (m == "jalr") {
+        if (ops.size() == 1) { if (!reg(0, rs)) return false; rd = RA; }
+        else if (!need(2) || !reg(0, rd) || !reg(1, rs)) return false;
+        emit(Op::JALR, rd, rs, 0, 0);
+        return true;
+    }
+    if (m == "syscall" || m == "nop") {
+        if (!need(0)) return false;
+        emit(m == "syscall" ? Op::SYSCALL : Op::NOP, 0, 0, 0, 0);
+        return true;
+    }
+    return fail(line, "unsupported instruction '" + m + "'");
+}
+
+uint8_t *MipsSim::byteAt(uint32_t addr) {
+    uint32_t page = addr >> 12;
+    if (page == lastPageNo && lastPage) return lastPage + (addr & 0xfff);
+    auto &p = pages[page];
+    if (!p) {
+        p.reset(new uint8_t[4096]());
+    }
+    lastPageNo = page;
+    lastPage = p.get();
+    return lastPage + (addr & 0xfff);
+}
+
+void MipsSim::touch(uint32_t addr) {
+    size_t blk = addr / cfg.lineBytes;
+    size_t idx = blk % cfg.cacheLines;
+    if (cacheTags[idx] == (uint32_t)blk) {
+        ++st.cacheHits;
+    } else {
+        cacheTags[idx] = (uint32_t)blk;
+        ++st.cacheMisses;
+        st.cycles += cfg.missPenalty;
+    }
+}
+
+bool MipsSim::run(std::istream &in, std::string &out) {
+    st = SimStats();
+    reg.fill(0);
+    hi = lo = 0;
+    pages.clear();
+    lastPage = nullptr;
+    lastPageNo = UINT32_MAX;
+    cacheTags.assign(cfg.cacheLines, UINT32_MAX);
+    reg[28] = (int32_t)GP_INIT;
+    reg[29] = (int32_t)SP_INIT;
+    for (size_t i = 0; i < data.size(); ++i) *byteAt(DATA_BASE + (uint32_t)i) = data[i];
+
+    std::vector<uint64_t> perFunc(funcNames.size(), 0);
+    size_t pc = 0;
+    while (pc < text.size()) {
+        if (st.instructions >= cfg.maxSteps) return fail(text[pc].line, "step limit exceeded");
+        const Inst &I = text[pc];
+        size_t next = pc + 1;
+        ++st.instructions;
+        ++st.cycles;
+        InstClass cls = classOf(I.op);
+        ++st.byClass[(size_t)cls];
+        if (funcOf[pc] >= 0) ++perFunc[(size_t)funcOf[pc]];
+
+        int32_t s = reg[I.rs], t = reg[I.rt];
+        uint32_t us = (uint32_t)s, ut = (uint32_t)t;
+        int32_t *d = &reg[I.rd];
+        uint32_t addr = us + (uint32_t)I.imm;
+        auto branch = [&](bool taken) {
+            if (taken) { next = (size_t)I.imm; ++st.branchesTaken; ++st.cycles; }
+        };
+
+        switch (I.op) {
+            case Op::ADD: case Op::ADDI: {
+                int64_t r = (int64_t)s + (I.op == Op::ADD ? t : I.imm);
+                if (r > INT32_MAX || r < INT32_MIN) return fail(I.line, "arithmetic overflow");
+                *d = (int32_t)r;
+                break;
+            }
+            case Op::SUB: {
+                int64_t r = (int64_t)s - t;
+                if (r > INT32_MAX || r < INT32_MIN) return fail(I.line, "arithmetic overflow");
+                *d = (int32_t)r;
+                break;
+            }
+            case Op::ADDU: *d = (int32_t)(us + ut); break;
+            case Op::SUBU: *d = (int32_t)(us - ut); break;
+            case Op::AND: *d = s & t; break;
+            case Op::OR: *d = s | t; break;
+            case Op::XOR: *d = s ^ t; break;
+            case Op::NOR: *d = ~(s | t); break;
+            case Op::SLT: *d = s < t; break;
+            case Op::SLTU: *d = us < ut; break;
+            case Op::SLLV: *d = (int32_t)(ut << (us & 31)); break;
+            case Op::SRLV: *d = (int32_t)(ut >> (us & 31)); break;
+            case Op::SRAV: *d = t >> (us & 31); break;
+            case Op::MUL: *d = (int32_t)((int64_t)s * t); st.cycles += 2; break;
+            case Op::MOVN: if (t != 0) *d = s; break;
+            case Op::MOVZ: if (t == 0) *d = s; break;
+            case Op::ADDIU: *d = (int32_t)(us + (uint32_t)I.imm); break;
+            case Op::ANDI: *d = (int32_t)(us & (uint32_t)I.imm); break;
+            case Op::ORI: *d = (int32_t)(us | (uint32_t)I.imm); break;
+            case Op::XORI: *d = (int32_t)(us ^ (uint32_t)I.imm); break;
+            case Op::SLTI: *d = s < I.imm; break;
+            case Op::SLTIU: *d = us < (uint32_t)I.imm; break;
+            case Op::LUI: *d = (int32_t)((uint32_t)I.imm << 16); break;
+            case Op::SLL: *d = (int32_t)(ut << I.imm); break;
+            case Op::SRL: *d = (int32_t)(ut >> I.imm); break;
+            case Op::SRA: *d = t >> I.imm; break;
+            case Op::MULT: {
+                int64_t r = (int64_t)s * t;
+                lo = (int32_t)r; hi = (int32_t)(r >> 32); st.cycles += 2;
+                break;
+            }
+            case Op::MULTU: {
+                uint64_t r = (uint64_t)us * ut;
+                lo = (int32_t)r; hi = (int32_t)(r >> 32); st.cycles += 2;
+                break;
+            }
+            case Op::DIV:
+                // 除零时 MIPS 结果未定义，这里保持 hi/lo 不变
+                if (t != 0) {
+                    if (s == INT32_MIN && t == -1) { lo = INT32_MIN; hi = 0; }
+                    else { lo = s / t; hi = s % t; }
+                }
+                st.cycles += 31;
+                break;
+            case Op::DIVU:
+                if (ut != 0) { lo = (int32_t)(us / ut); hi = (int32_t)(us % ut); }
+                st.cycles += 31;
+                break;
+            case Op::MFHI: *d = hi; break;
+            case Op::MFLO: *d = lo; break;
+            case Op::MTHI: hi = s; break;
+            case Op::MTLO: lo = s; break;
+            case Op::LW: case Op::SW:
+                if (addr & 3) return fail(I.line, "unaligned word access");
+                touch(addr);
+                if (I.op == Op::LW) {
+                    uint8_t *p = byteAt(addr);
+                    reg[I.rt] = (int32_t)(p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24));
+                } else {
+                    uint8_t *p = byteAt(addr);
+                    for (int b = 0; b < 4; ++b) p[b] = (uint8_t)(ut >> (8 * b));
+                }
+                break;
+            case Op::LH: case Op::LHU: case Op::SH:
+                if (addr & 1) return fail(I.line, "unaligned halfword access");
+                touch(addr);
+                {
+                    uint8_t *p = byteAt(addr);
+                    if (I.op == Op::SH) { p[0] = (uint8_t)ut; p[1] = (uint8_t)(ut >> 8); }
+                    else {
+                        uint16_t h = (uint16_t)(p[0] | (p[1] << 8));
+                        reg[I.rt] = I.op == Op::LH ? (int32_t)(int16_t)h : (int32_t)h;
+                    }
+                }
+                break;
+            case Op::LB: case Op::LBU: case Op::SB:
+                touch(addr);
+                if (I.op == Op::SB) *byteAt(addr) = (uint8_t)ut;
+                else {
+                    uint8_t b = *byteAt(addr);
+                    reg[I.rt] = I.op == Op::LB ? (int32_t)(int8_t)b : (int32_t)b;
+                }
+                break;
+            case Op::BEQ: branch(s == t); break;
+            case Op::BNE: branch(s != t); break;
+            case Op::BLEZ: branch(s <= 0); break;
+            case Op::BGTZ: branch(s > 0); break;
+            case Op::BLTZ: branch(s < 0); break;
+            case Op::BGEZ: branch(s >= 0); break;
+            case Op::J: next = (size_t)I.imm; ++st.cycles; break;
+            case Op::JAL:
+                reg[RA] = (int32_t)(TEXT_BASE + 4 * (uint32_t)(pc + 1));
+                next = (size_t)I.imm; ++st.cycles;
+                break;
+            case Op::JR: case Op::JALR:
+                if (us < TEXT_BASE || (us - TEXT_BASE) % 4 != 0 || (us - TEXT_BASE) / 4 > text.size())
+                    return fail(I.line, "jump to invalid address");
+                if (I.op == Op::JALR) reg[I.rd] = (int32_t)(TEXT_BASE + 4 * (uint32_t)(pc + 1));
+                next = (us - TEXT_BASE) / 4; ++st.cycles;
+                break;
+            case Op::SYSCALL:
+                switch (reg[V0]) {
+                    case 1: out += std::to_string(reg[A0]); break;
+                    case 4:
+                        for (uint32_t a = (uint32_t)reg[A0]; ; ++a) {
+                            char c = (char)*byteAt(a);
+                            if (c == '\0') break;
+                            out.push_back(c);
+                        }
+                        break;
+                    case 5: {
+                        int64_t x = 0;
+                        if (!(in >> x)) return fail(I.line, "read_int: no more input");
+                        reg[V0] = (int32_t)x;
+                        break;
+                    }
+                    case 10: next = text.size(); break;
+                    case 11: out.push_back((char)reg[A0]); break;
+                    case 12: {
+                        char c = 0;
+                        in.get(c);
+                        reg[V0] = (unsigned char)c;
+                        break;
+                    }
+                    default: return fail(I.line, "unsupported syscall " + std::to_string(reg[V0]));
+                }
+                break;
+            case Op::NOP: break;
+        }
+        reg[0] = 0;
+        pc = next;
+    }
+
+    for (size_t i = 0; i < funcNames.size(); ++i) st.functions.emplace_back(funcNames[i], perFunc[i]);
+    std::stable_sort(st.functions.begin(), st.functions.end(),
+                     [](auto &a, auto &b){ return a.second > b.second; });
+    return true;
+}
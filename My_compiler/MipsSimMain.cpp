@@ -0,0 +1,95 @@
+#include "MipsSim.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace {
+
+bool readFile(const std::string &path, std::string &out) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) return false;
+    out.assign((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// 比较输出时忽略 \r 和末尾空白（outputN.txt 末尾有无换行不统一）
+std::string normalize(const std::string &s) {
+    std::string r;
+    for (char c : s) if (c != '\r') r.push_back(c);
+    while (!r.empty() && std::isspace((unsigned char)r.back())) r.pop_back();
+    return r;
+}
+
+void printStats(const SimStats &st, std::ostream &os) {
+    os << "instructions " << st.instructions << "\n";
+    for (size_t i = 0; i < (size_t)InstClass::COUNT; ++i)
+        os << "  " << std::left << std::setw(8) << instClassName((InstClass)i) << st.byClass[i] << "\n";
+    os << "branches taken " << st.branchesTaken << "\n";
+    os << "dcache hits " << st.cacheHits << " misses " << st.cacheMisses << "\n";
+    os << "cycles (est.) " << st.cycles << "\n";
+    os << "weighted cost " << std::fixed << std::setprecision(1) << st.weightedCost() << "\n";
+    os << "functions:\n";
+    for (auto &f : st.functions)
+        if (f.second) os << "  " << std::left << std::setw(20) << f.first << f.second << "\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    // 用法：mips_sim [--input in.txt] [--expect out.txt] [--stats] [--max-steps N] mips.txt
+    std::string asmFile, inputFile, expectFile;
+    bool showStats = false;
+    SimConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--input" && i + 1 < argc) inputFile = argv[++i];
+        else if (a == "--expect" && i + 1 < argc) expectFile = argv[++i];
+        else if (a == "--stats") showStats = true;
+        else if (a == "--max-steps" && i + 1 < argc) cfg.maxSteps = std::stoull(argv[++i]);
+        else asmFile = a;
+    }
+    if (asmFile.empty()) asmFile = "mips.txt";
+
+    std::string src;
+    if (!readFile(asmFile, src)) {
+        std::cerr << "Cannot open input file: " << asmFile << "\n";
+        return 1;
+    }
+    MipsSim sim(cfg);
+    if (!sim.load(src)) {
+        std::cerr << asmFile << ": " << sim.error() << "\n";
+        return 1;
+    }
+
+    std::string out;
+    bool ok;
+    if (!inputFile.empty()) {
+        std::ifstream in(inputFile);
+        if (!in) {
+            std::cerr << "Cannot open input file: " << inputFile << "\n";
+            return 1;
+        }
+        ok = sim.run(in, out);
+    } else {
+        ok = sim.run(std::cin, out);
+    }
+    std::cout << out;
+    std::cout.flush();
+    if (!ok) std::cerr << asmFile << ": runtime error: " << sim.error() << "\n";
+    if (showStats) printStats(sim.stats(), std::cerr);
+    if (!ok) return 1;
+
+    if (!expectFile.empty()) {
+        std::string expected;
+        if (!readFile(expectFile, expected)) {
+            std::cerr << "Cannot open input file: " << expectFile << "\n";
+            return 1;
+        }
+        if (normalize(out) != normalize(expected)) {
+            std::cerr << "output differs from " << expectFile << "\n";
+            return 3;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,17 @@
+# 用 sysy_gen 按一段种子生成程序，逐个交给 RunLexerCase.cmake 检查没有词法错误
+# 参数：GENERATOR、COMPILER、FIRST_SEED、LAST_SEED、WORK_DIR
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+set(root_dir "${WORK_DIR}")
+foreach(seed RANGE ${FIRST_SEED} ${LAST_SEED})
+    set(TESTFILE "${root_dir}/seed${seed}.txt")
+    execute_process(
+        COMMAND "${GENERATOR}" --seed ${seed} -o "${TESTFILE}"
+        RESULT_VARIABLE rc)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "sysy_gen --seed ${seed} exited with ${rc}")
+    endif()
+    set(WORK_DIR "${root_dir}/seed${seed}")
+    message(STATUS "seed ${seed}")
+    include("${CMAKE_CURRENT_LIST_DIR}/RunLexerCase.cmake")
+endforeach()
@@ -0,0 +1,46 @@
+# 在独立目录里对一个测试程序运行 Compiler，并与期望输出比较
+# 参数：COMPILER、TESTFILE、WORK_DIR，可选 ANSWER（省略时只要求没有词法错误），
+# 可选 EXACT（逐字节比较，不忽略 \r 与末尾空白）
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+execute_process(
+    COMMAND "${COMPILER}" "${TESTFILE}"
+    WORKING_DIRECTORY "${WORK_DIR}"
+    RESULT_VARIABLE rc)
+if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "Compiler exited with ${rc}")
+endif()
+
+# 有错误时只输出 error.txt，否则只输出 lexer.txt
+if(EXISTS "${WORK_DIR}/error.txt")
+    if(EXISTS "${WORK_DIR}/lexer.txt")
+        message(FATAL_ERROR "partial lexer.txt left next to error.txt")
+    endif()
+    set(actual_file "${WORK_DIR}/error.txt")
+else()
+    set(actual_file "${WORK_DIR}/lexer.txt")
+endif()
+if(NOT EXISTS "${actual_file}")
+    message(FATAL_ERROR "no output produced")
+endif()
+
+if(NOT DEFINED ANSWER)
+    if(EXISTS "${WORK_DIR}/error.txt")
+        file(READ "${WORK_DIR}/error.txt" errors)
+        message(FATAL_ERROR "unexpected lexical errors:\n${errors}")
+    endif()
+    return()
+endif()
+
+# 默认比较时忽略 \r 与末尾空白
+file(READ "${actual_file}" actual)
+file(READ "${ANSWER}" expected)
+if(NOT EXACT)
+    foreach(v actual expected)
+        string(REPLACE "\r" "" ${v} "${${v}}")
+        string(STRIP "${${v}}" ${v})
+    endforeach()
+endif()
+if(NOT actual STREQUAL expected)
+    message(FATAL_ERROR "output differs from ${ANSWER}\n--- actual ---\n${actual}")
+endif()
@@ -0,0 +1,53 @@
+// SourceManager.cpp
+#include "SourceManager.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+
+SourceManager::SourceManager(const std::string &inputFile) : indexed(false) {
+    // 读整个文件
+    std::ifstream ifs(inputFile);
+    if (!ifs) {
+        std::cerr << "Cannot open input file: " << inputFile << "\n";
+        exit(1);
+    }
+    text.assign((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+}
+
+void SourceManager::buildIndex() const {
+    // 用 memchr 一次扫描整段缓冲区（库实现是向量化的），不再逐字节判断 '\n'
+    lineStarts.clear();
+    lineStarts.push_back(0);
+    const char *begin = text.data();
+    const char *end = begin + text.size();
+    const char *p = begin;
+    while (p < end) {
+        const void *hit = std::memchr(p, '\n', (size_t)(end - p));
+        if (!hit) break;
+        p = static_cast<const char *>(hit) + 1;
+        lineStarts.push_back((size_t)(p - begin));
+    }
+    indexed = true;
+}
+
+size_t SourceManager::lineIndexOf(size_t offset) const {
+    if (!indexed) buildIndex();
+    // 最后一个 <= offset 的行首
+    auto it = std::upper_bound(lineStarts.begin(), lineStarts.end(), offset);
+    return (size_t)(it - lineStarts.begin()) - 1;
+}
+
+int SourceManager::lineOf(size_t offset) const {
+    return (int)lineIndexOf(offset) + 1;
+}
+
+int SourceManager::columnOf(size_t offset) const {
+    return (int)(offset - lineStarts[lineIndexOf(offset)]) + 1;
+}
+
+size_t SourceManager::lineCount() const {
+    if (!indexed) buildIndex();
+    return lineStarts.size();
+}
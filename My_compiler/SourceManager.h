@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// 源文件管理：持有整个源文件内容，按需把字节偏移换算成行列号
+class SourceManager {
+public:
+    SourceManager(const std::string &inputFile);
+
+    const std::string &buffer() const { return text; }
+
+    // 行号、列号均从 1 开始；列号按字节计
+    int lineOf(size_t offset) const;
+    int columnOf(size_t offset) const;
+    size_t lineCount() const;
+
+private:
+    std::string text;
+    // 每一行首字节的偏移，第一次查询时才建立
+    mutable std::vector<size_t> lineStarts;
+    mutable bool indexed;
+
+    void buildIndex() const;
+    size_t lineIndexOf(size_t offset) const;
+};
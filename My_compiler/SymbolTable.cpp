@@ -0,0 +1,73 @@
+// SymbolTable.cpp
+#include "SymbolTable.h"
+
+int Interner::intern(const std::string &name) {
+    auto it = ids.find(name);
+    if (it != ids.end()) return it->second;
+    int id = (int)names.size();
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+SymbolTable::SymbolTable() : slots(64), usedSlots(0) {}
+
+size_t SymbolTable::findSlot(int nameId) const {
+    // 编号是连续小整数，乘法散列后线性探测
+    size_t mask = slots.size() - 1;
+    size_t i = ((uint32_t)nameId * 2654435761u) & mask;
+    while (slots[i].nameId != -1 && slots[i].nameId != nameId) i = (i + 1) & mask;
+    return i;
+}
+
+void SymbolTable::grow() {
+    std::vector<Slot> old;
+    old.swap(slots);
+    slots.assign(old.size() * 2, Slot());
+    for (const Slot &s : old) {
+        if (s.nameId != -1) slots[findSlot(s.nameId)] = s;
+    }
+}
+
+void SymbolTable::enterScope() {
+    scopeMarks.push_back(entries.size());
+}
+
+void SymbolTable::exitScope() {
+    if (scopeMarks.empty()) return;
+    size_t mark = scopeMarks.back();
+    scopeMarks.pop_back();
+    // 槽位中的名字保留，只把可见声明恢复成被遮蔽的那一条
+    while (entries.size() > mark) {
+        const Entry &e = entries.back();
+        slots[findSlot(e.nameId)].entry = e.shadowed;
+        entries.pop_back();
+    }
+}
+
+bool SymbolTable::declare(int nameId, const SymbolInfo &info) {
+    // 负载因子不超过 1/2
+    if ((usedSlots + 1) * 2 > slots.size()) grow();
+    size_t i = findSlot(nameId);
+    Slot &s = slots[i];
+    if (s.nameId == -1) {
+        s.nameId = nameId;
+        ++usedSlots;
+    }
+    if (s.entry != -1 && entries[(size_t)s.entry].scope == depth()) return false;
+    entries.push_back(Entry{info, nameId, s.entry, depth()});
+    s.entry = (int)entries.size() - 1;
+    return true;
+}
+
+const SymbolInfo *SymbolTable::lookup(int nameId) const {
+    const Slot &s = slots[findSlot(nameId)];
+    if (s.entry == -1) return nullptr;
+    return &entries[(size_t)s.entry].info;
+}
+
+int SymbolTable::scopeOf(int nameId) const {
+    const Slot &s = slots[findSlot(nameId)];
+    if (s.entry == -1) return -1;
+    return entries[(size_t)s.entry].scope;
+}
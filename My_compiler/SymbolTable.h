@@ -0,0 +1,66 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// 标识符驻留：同名标识符只保存一份，之后各阶段只比较整数编号
+class Interner {
+public:
+    int intern(const std::string &name);
+    const std::string &name(int id) const { return names[(size_t)id]; }
+    size_t size() const { return names.size(); }
+
+private:
+    std::unordered_map<std::string, int> ids;
+    std::vector<std::string> names;
+};
+
+enum class SymbolKind { Var, Const, Func };
+
+struct SymbolInfo {
+    SymbolKind kind = SymbolKind::Var;
+    bool isArray = false;
+    bool isStatic = false;
+    bool returnsVoid = false;   // 仅对函数有效
+    int paramCount = 0;         // 仅对函数有效
+    int line = 0;               // 声明所在行
+};
+
+// 作用域符号表：一张开放寻址哈希表记录每个名字当前可见的声明，
+// 声明按顺序压入撤销日志，退出作用域时只回退本层声明过的条目
+class SymbolTable {
+public:
+    SymbolTable();
+
+    void enterScope();
+    void exitScope();
+    int depth() const { return (int)scopeMarks.size(); } // 全局作用域为 0
+
+    // 在当前作用域声明；同一作用域内重名时返回 false（错误 b）
+    bool declare(int nameId, const SymbolInfo &info);
+    // 由内向外查找，找不到返回 nullptr（错误 c）
+    const SymbolInfo *lookup(int nameId) const;
+    // 声明所在作用域深度，未声明返回 -1
+    int scopeOf(int nameId) const;
+
+private:
+    struct Slot {
+        int nameId = -1;   // -1 表示空槽
+        int entry = -1;    // 当前可见声明在 entries 中的下标，-1 表示无
+    };
+    struct Entry {
+        SymbolInfo info;
+        int nameId;
+        int shadowed;      // 被本条遮蔽的外层声明，退出作用域时恢复
+        int scope;
+    };
+
+    std::vector<Slot> slots;          // 容量始终为 2 的幂
+    size_t usedSlots;
+    std::vector<Entry> entries;       // 撤销日志
+    std::vector<size_t> scopeMarks;   // 每层作用域开始时 entries 的长度
+
+    size_t findSlot(int nameId) const;
+    void grow();
+};
@@ -0,0 +1,342 @@
+// SysyGen.cpp
+#include "SysyGen.h"
+#include <unordered_set>
+#include <cctype>
+#include <algorithm>
+
+ProgramGenerator::ProgramGenerator(const GenConfig &cfg)
+    : cfg(cfg), rng(cfg.seed), indent(0), loopNest(0), blockNest(0),
+      freshId(0), defined(0) {
+    // 超过上限的深度按上限生成，保证求值不溢出
+    this->cfg.exprDepth = std::max(0, std::min(cfg.exprDepth, GenConfig::MAX_EXPR_DEPTH));
+}
+
+int ProgramGenerator::rand(int lo, int hi) {
+    return std::uniform_int_distribution<int>(lo, hi)(rng);
+}
+
+bool ProgramGenerator::chance(int percent) { return rand(1, 100) <= percent; }
+
+void ProgramGenerator::line(const std::string &s) {
+    out << std::string((size_t)indent * 4, ' ') << s << "\n";
+}
+
+std::string ProgramGenerator::newName() {
+    // 优先从名字池里取当前作用域还没用过的名字，制造跨作用域的同名遮蔽
+    std::unordered_set<std::string> used;
+    for (auto &v : scopes.back()) used.insert(v.name);
+    if (cfg.identifiers > 0) {
+        for (int tries = 0; tries < 4; ++tries) {
+            std::string n = "v" + std::to_string(rand(0, cfg.identifiers - 1));
+            if (!used.count(n)) return n;
+        }
+    }
+    return "t" + std::to_string(freshId++);
+}
+
+std::string ProgramGenerator::nameAvoiding(const std::string &init) {
+    // 声明的名字在自己的初值里已经可见，初值若用到同名外层变量就换一个新名字
+    std::string n = newName();
+    for (size_t p = init.find(n); p != std::string::npos; p = init.find(n, p + 1)) {
+        bool before = p > 0 && (std::isalnum((unsigned char)init[p-1]) || init[p-1] == '_');
+        size_t e = p + n.size();
+        bool after = e < init.size() && (std::isalnum((unsigned char)init[e]) || init[e] == '_');
+        if (!before && !after) return "t" + std::to_string(freshId++);
+    }
+    return n;
+}
+
+void ProgramGenerator::declare(const Var &v) { scopes.back().push_back(v); }
+
+std::vector<const ProgramGenerator::Var *> ProgramGenerator::visible(bool arrays, bool assignable) const {
+    std::vector<const Var *> r;
+    std::unordered_set<std::string> seen;
+    for (auto s = scopes.rbegin(); s != scopes.rend(); ++s) {
+        for (auto v = s->rbegin(); v != s->rend(); ++v) {
+            if (!seen.insert(v->name).second) continue;
+            if (v->isArray != arrays) continue;
+            if (assignable && (v->isConst || v->locked)) continue;
+            r.push_back(&*v);
+        }
+    }
+    return r;
+}
+
+std::string ProgramGenerator::index(int depth) {
+    if (depth <= 0 || chance(60)) return std::to_string(rand(0, ARRAY_LEN - 1));
+    std::string n = std::to_string(ARRAY_LEN);
+    return "((" + expr(depth - 1) + ") % " + n + " + " + n + ") % " + n;
+}
+
+std::string ProgramGenerator::callExpr(const Func &f, int depth) {
+    std::string s = f.name + "(";
+    for (size_t i = 0; i < f.params.size(); ++i) {
+        if (i) s += ", ";
+        if (f.params[i]) {
+            auto arrs = visible(true, false);
+            s += arrs[(size_t)rand(0, (int)arrs.size() - 1)]->name;
+        } else {
+            s += value(depth - 1);
+        }
+    }
+    return s + ")";
+}
+
+std::string ProgramGenerator::primary(int depth) {
+    auto scalars = visible(false, false);
+    auto arrays = visible(true, false);
+    std::vector<const Func *> callable;
+    if (depth > 0) {
+        for (int i = 0; i < defined; ++i) {
+            const Func &f = funcs[(size_t)i];
+            if (!f.returnsInt) continue;
+            bool needsArray = false;
+            for (bool p : f.params) needsArray = needsArray || p;
+            if (needsArray && arrays.empty()) continue;
+            callable.push_back(&f);
+        }
+    }
+    int k = rand(0, 9);
+    if (k < 3 || (scalars.empty() && arrays.empty() && callable.empty()))
+        return std::to_string(rand(0, 100));
+    if (k < 6 && !scalars.empty())
+        return scalars[(size_t)rand(0, (int)scalars.size() - 1)]->name;
+    if (k < 8 && !arrays.empty())
+        return arrays[(size_t)rand(0, (int)arrays.size() - 1)]->name + "[" + index(depth - 1) + "]";
+    if (!callable.empty() && chance(50))
+        return callExpr(*callable[(size_t)rand(0, (int)callable.size() - 1)], depth);
+    if (depth > 0) return "(" + expr(depth - 1) + ")";
+    return std::to_string(rand(0, 100));
+}
+
+std::string ProgramGenerator::expr(int depth) {
+    if (depth <= 0 || chance(30)) {
+        std::string p = primary(depth);
+        if (chance(10)) return "-" + p;
+        return p;
+    }
+    static const char *ops[] = {"+", "-", "*", "/", "%"};
+    const char *op = ops[rand(0, 4)];
+    std::string lhs = expr(depth - 1);
+    // 除数、模数只用非零常量；乘数也只用小常量，每层至多放大 9 倍
+    std::string rhs = op[0] == '+' || op[0] == '-' ? expr(depth - 1) : std::to_string(rand(1, 9));
+    return lhs + " " + op + " " + rhs;
+}
+
+std::string ProgramGenerator::value(int depth) {
+    // 写入变量、数组元素、形参和返回值的结果都取模，存下来的值始终小于 VALUE_MOD
+    return "(" + expr(depth) + ") % " + std::to_string(VALUE_MOD);
+}
+
+std::string ProgramGenerator::cond(int depth) {
+    static const char *rel[] = {"<", ">", "<=", ">=", "==", "!="};
+    // ! 只能出现在条件里，且作用于一元表达式
+    std::string lhs = chance(10) ? "!" + primary(depth - 1) : expr(depth - 1);
+    std::string c = lhs + " " + rel[rand(0, 5)] + " " + expr(depth - 1);
+    if (depth > 1 && chance(30)) c += (chance(50) ? " && " : " || ") + cond(depth - 1);
+    return c;
+}
+
+void ProgramGenerator::globalDecls() {
+    int n = rand(1, 3);
+    std::string c = "const int ";
+    for (int i = 0; i < n; ++i) {
+        Var v{newName(), false, true, false};
+        c += (i ? ", " : "") + v.name + " = " + std::to_string(rand(-5, 50));
+        declare(v);
+    }
+    line(c + ";");
+    for (int i = 0, m = rand(1, 4); i < m; ++i) {
+        Var v{newName(), false, false, false};
+        std::string s = chance(30) ? "static int " : "int ";
+        s += v.name;
+        if (chance(70)) s += " = " + std::to_string(rand(0, 99));
+        line(s + ";");
+        declare(v);
+    }
+    for (int i = 0, m = rand(1, 2); i < m; ++i) {
+        Var v{newName(), true, false, false};
+        std::string s = (chance(30) ? "static int " : "int ") + v.name + "[" + std::to_string(ARRAY_LEN) + "]";
+        if (chance(70)) {
+            // 部分初始化，剩余元素为 0
+            s += " = {";
+            for (int k = 0, len = rand(1, ARRAY_LEN); k < len; ++k) s += (k ? ", " : "") + std::to_string(rand(0, 20));
+            s += "}";
+        }
+        line(s + ";");
+        declare(v);
+    }
+    line("");
+}
+
+void ProgramGenerator::localDecl() {
+    int k = rand(0, 9);
+    if (k < 2) {
+        Var v{newName(), false, true, false};
+        line("const int " + v.name + " = " + std::to_string(rand(0, 30)) + ";");
+        declare(v);
+    } else if (k < 4) {
+        std::string init;
+        for (int i = 0, len = rand(1, ARRAY_LEN); i < len; ++i) init += (i ? ", " : "") + value(cfg.exprDepth - 1);
+        Var v{nameAvoiding(init), true, false, false};
+        line("int " + v.name + "[" + std::to_string(ARRAY_LEN) + "] = {" + init + "};");
+        declare(v);
+    } else {
+        std::string init = value(cfg.exprDepth);
+        Var v{nameAvoiding(init), false, false, false};
+        line("int " + v.name + " = " + init + ";");
+        declare(v);
+    }
+}
+
+void ProgramGenerator::printfStmt() {
+    int args = rand(0, 3);
+    std::string fmt;
+    static const char letters[] = "abcdefghijklmnopqrstuvwxyz";
+    for (int i = 0; i <= args; ++i) {
+        for (int k = 0, len = rand(0, 6); k < len; ++k) fmt.push_back(letters[rand(0, 25)]);
+        if (i < args) fmt += (chance(50) ? " = %d" : "%d");
+    }
+    std::string s = "printf(\"" + fmt + "\\n\"";
+    for (int i = 0; i < args; ++i) s += ", " + expr(cfg.exprDepth);
+    line(s + ");");
+}
+
+void ProgramGenerator::forStmt() {
+    Var iv{newName(), false, false, false};
+    line("int " + iv.name + " = 0;");
+    declare(iv);
+    size_t scopeIdx = scopes.size() - 1, varIdx = scopes.back().size() - 1;
+    std::string bound = std::to_string(rand(1, 4));
+    line("for (" + iv.name + " = 0; " + iv.name + " < " + bound + "; " + iv.name + " = " + iv.name + " + 1) {");
+    scopes[scopeIdx][varIdx].locked = true;
+    ++loopNest;
+    block(cfg.stmtsPerBlock);
+    --loopNest;
+    scopes[scopeIdx][varIdx].locked = false;
+    line("}");
+}
+
+void ProgramGenerator::block(int stmts) {
+    scopes.emplace_back();
+    body(stmts);
+    scopes.pop_back();
+}
+
+void ProgramGenerator::body(int stmts) {
+    ++indent;
+    ++blockNest;
+    for (int i = 0; i < stmts; ++i) {
+        if (chance(25)) localDecl();
+        else stmt();
+    }
+    --blockNest;
+    --indent;
+}
+
+void ProgramGenerator::stmt() {
+    bool nest = blockNest < cfg.blockDepth;
+    int k = rand(0, 99);
+    if (k < 30) {
+        auto scalars = visible(false, true);
+        if (!scalars.empty()) {
+            line(scalars[(size_t)rand(0, (int)scalars.size() - 1)]->name + " = " + value(cfg.exprDepth) + ";");
+            return;
+        }
+    } else if (k < 42) {
+        auto arrays = visible(true, true);
+        if (!arrays.empty()) {
+            auto a = arrays[(size_t)rand(0, (int)arrays.size() - 1)];
+            line(a->name + "[" + index(cfg.exprDepth - 1) + "] = " + value(cfg.exprDepth) + ";");
+            return;
+        }
+    } else if (k < 57 && nest) {
+        line("if (" + cond(cfg.exprDepth) + ") {");
+        block(cfg.stmtsPerBlock / 2 + 1);
+        if (chance(50)) {
+            line("} else {");
+            block(cfg.stmtsPerBlock / 2 + 1);
+        }
+        line("}");
+        return;
+    } else if (k < 67 && nest && loopNest < cfg.loopDepth) {
+        forStmt();
+        return;
+    } else if (k < 72 && loopNest > 0) {
+        line("if (" + cond(cfg.exprDepth) + ") " + (chance(50) ? "break;" : "continue;"));
+        return;
+    } else if (k < 80) {
+        printfStmt();
+        return;
+    } else if (k < 88) {
+        bool haveArrays = !visible(true, false).empty();
+        std::vector<const Func *> voids;
+        for (int i = 0; i < defined; ++i) {
+            const Func &f = funcs[(size_t)i];
+            bool needsArray = false;
+            for (bool p : f.params) needsArray = needsArray || p;
+            if (!f.returnsInt && (haveArrays || !needsArray)) voids.push_back(&f);
+        }
+        if (!voids.empty()) {
+            line(callExpr(*voids[(size_t)rand(0, (int)voids.size() - 1)], cfg.exprDepth) + ";");
+            return;
+        }
+    } else if (nest) {
+        line("{");
+        block(cfg.stmtsPerBlock / 2 + 1);
+        line("}");
+        return;
+    }
+    line(expr(cfg.exprDepth) + ";");
+}
+
+void ProgramGenerator::function(const Func &f) {
+    std::string sig = (f.returnsInt ? "int " : "void ") + f.name + "(";
+    scopes.emplace_back();
+    for (size_t i = 0; i < f.params.size(); ++i) {
+        Var p{"p" + std::to_string(i), f.params[i], false, false};
+        sig += (i ? ", int " : "int ") + p.name + (p.isArray ? "[]" : "");
+        declare(p);
+    }
+    // 形参与函数体同一作用域，末尾的 return 在其中生成，才能看到体内的局部变量
+    line(sig + ") {");
+    body(cfg.stmtsPerBlock);
+    ++indent;
+    if (f.returnsInt) line("return " + value(cfg.exprDepth) + ";");
+    else if (chance(50)) line("return;");
+    --indent;
+    line("}");
+    line("");
+    scopes.pop_back();
+}
+
+std::string ProgramGenerator::generate() {
+    out.str("");
+    scopes.assign(1, {});
+    funcs.clear();
+    defined = 0;
+    globalDecls();
+    for (int i = 0; i < cfg.functions; ++i) {
+        Func f{"func" + std::to_string(i), chance(60), {}};
+        for (int k = 0, n = rand(0, 3); k < n; ++k) f.params.push_back(chance(25));
+        funcs.push_back(f);
+    }
+    for (int i = 0; i < cfg.functions; ++i) {
+        function(funcs[(size_t)i]);
+        ++defined;
+    }
+    line("int main() {");
+    scopes.emplace_back();
+    body(cfg.stmtsPerBlock * 2);
+    ++indent;
+    line("return 0;");
+    --indent;
+    line("}");
+    scopes.pop_back();
+    return out.str();
+}
+
+std::string generateProgram(const GenConfig &cfg) {
+    ProgramGenerator g(cfg);
+    return g.generate();
+}
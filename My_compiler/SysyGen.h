@@ -0,0 +1,83 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <random>
+#include <sstream>
+
+// 按文法随机生成合法的 SysY 程序，用来测各阶段随输入规模的伸缩性。
+// 生成的程序：先声明后使用、数组下标不越界、除数为非零常量、
+// 循环次数固定且只调用前面定义的函数，因此一定能正常结束。
+// 存下来的值都对 VALUE_MOD 取模，乘数只用 1~9 的常量，
+// exprDepth 不超过 MAX_EXPR_DEPTH 时表达式求值不会溢出
+struct GenConfig {
+    unsigned seed = 1;
+    int functions = 4;       // 除 main 外的函数个数
+    int stmtsPerBlock = 6;   // 每个语句块的语句数
+    int blockDepth = 3;      // 语句块最大嵌套层数
+    int exprDepth = 3;       // 表达式最大嵌套层数，不超过 MAX_EXPR_DEPTH
+    int loopDepth = 2;       // for 最大嵌套层数
+    int identifiers = 16;    // 变量名池大小，越小同名遮蔽越多
+
+    // 存下的值小于 10^4，每层至多放大 9 倍，10^4·9^5 仍在 int 范围内
+    static constexpr int MAX_EXPR_DEPTH = 5;
+};
+
+class ProgramGenerator {
+public:
+    explicit ProgramGenerator(const GenConfig &cfg);
+    std::string generate();
+
+private:
+    struct Var {
+        std::string name;
+        bool isArray;
+        bool isConst;
+        bool locked;         // 作为循环变量时循环体内不可赋值
+    };
+    struct Func {
+        std::string name;
+        bool returnsInt;
+        std::vector<bool> params;   // true 表示数组参数
+    };
+
+    GenConfig cfg;
+    std::mt19937 rng;
+    std::ostringstream out;
+    std::vector<std::vector<Var>> scopes;
+    std::vector<Func> funcs;
+    int indent;
+    int loopNest;
+    int blockNest;
+    int freshId;
+    int defined;         // 已生成的函数个数，只能调用这些函数
+
+    static const int ARRAY_LEN = 8;
+    static const int VALUE_MOD = 10000;
+
+    int rand(int lo, int hi);      // [lo, hi]
+    bool chance(int percent);
+    void line(const std::string &s);
+
+    std::string newName();
+    std::string nameAvoiding(const std::string &init);
+    void declare(const Var &v);
+    std::vector<const Var *> visible(bool arrays, bool assignable) const;
+
+    std::string expr(int depth);
+    std::string value(int depth);     // 要存下来的表达式，结果在 (-VALUE_MOD, VALUE_MOD) 内
+    std::string primary(int depth);
+    std::string cond(int depth);
+    std::string callExpr(const Func &f, int depth);
+    std::string index(int depth);
+
+    void globalDecls();
+    void function(const Func &f);
+    void localDecl();
+    void block(int stmts);         // 新开一层作用域
+    void body(int stmts);          // 在当前作用域内生成语句
+    void stmt();
+    void forStmt();
+    void printfStmt();
+};
+
+std::string generateProgram(const GenConfig &cfg);
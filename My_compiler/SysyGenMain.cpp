@@ -0,0 +1,56 @@
+#include "SysyGen.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <exception>
+
+static int usage() {
+    std::cerr << "usage: sysy_gen [--seed N] [--funcs N] [--stmts N] [--depth N] [--expr-depth N]\n"
+                 "                [--loop-depth N] [--idents N] [-o testfile.txt]\n"
+                 "  --expr-depth must be between 0 and " << GenConfig::MAX_EXPR_DEPTH << "\n";
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    GenConfig cfg;
+    std::string outFile;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "missing value for " << a << "\n";
+            return usage();
+        }
+        std::string v = argv[++i];
+        try {
+            if (a == "--seed") cfg.seed = (unsigned)std::stoul(v);
+            else if (a == "--funcs") cfg.functions = std::stoi(v);
+            else if (a == "--stmts") cfg.stmtsPerBlock = std::stoi(v);
+            else if (a == "--depth") cfg.blockDepth = std::stoi(v);
+            else if (a == "--expr-depth") cfg.exprDepth = std::stoi(v);
+            else if (a == "--loop-depth") cfg.loopDepth = std::stoi(v);
+            else if (a == "--idents") cfg.identifiers = std::stoi(v);
+            else if (a == "-o") outFile = v;
+            else {
+                std::cerr << "unknown option " << a << "\n";
+                return usage();
+            }
+        } catch (const std::exception &) {
+            std::cerr << "invalid value for " << a << ": " << v << "\n";
+            return usage();
+        }
+    }
+    // 表达式更深时求值可能溢出，生成的程序就不再保证合法
+    if (cfg.exprDepth < 0 || cfg.exprDepth > GenConfig::MAX_EXPR_DEPTH) {
+        std::cerr << "--expr-depth out of range: " << cfg.exprDepth << "\n";
+        return usage();
+    }
+
+    std::string program = generateProgram(cfg);
+    if (outFile.empty()) {
+        std::cout << program;
+    } else {
+        std::ofstream ofs(outFile);
+        ofs << program;
+    }
+    return 0;
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <cstddef>
 
 enum class TokenType {
     // 基本类别（按题目类别码名称）
@@ -61,7 +62,8 @@ inline std::string tokenTypeToString(TokenType t) {
 struct Token {
     TokenType type;
     std::string lexeme; // 原样字符串（例如数字的原始字符、字符串要含双引号）
-    int line;
-    Token(TokenType t = TokenType::UNKNOWN, const std::string &s = "", int l = 1)
-        : type(t), lexeme(s), line(l) {}
+    size_t offset;      // 首字符在源文件中的字节偏移，行列号经 SourceManager 换算
+    int symbol;         // IDENFR 的驻留编号（见 Interner），其他记号为 -1
+    Token(TokenType t = TokenType::UNKNOWN, const std::string &s = "", size_t off = 0, int sym = -1)
+        : type(t), lexeme(s), offset(off), symbol(sym) {}
 };
@@ -0,0 +1,14 @@
+#pragma once
+#include <iostream>
+
+// 单元测试共用的断言：失败时打印位置并计数，不中断后续检查，
+// main 结束时用 testResult 汇总
+static int failures = 0;
+#define CHECK(cond) do { if (!(cond)) { std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #cond ") failed\n"; ++failures; } } while (0)
+
+// 全部通过时打印 "<name> passed" 并返回 0，否则返回 1
+inline int testResult(const char *name) {
+    if (failures) return 1;
+    std::cout << name << " passed\n";
+    return 0;
+}
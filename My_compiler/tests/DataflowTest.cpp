@@ -0,0 +1,192 @@
+#include "Dataflow.h"
+#include "Check.h"
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+template <class Set>
+static std::set<size_t> elems(const Set &s) {
+    std::set<size_t> r;
+    s.forEach([&](size_t e) { r.insert(e); });
+    return r;
+}
+
+// 两种位集各自的运算，全集大小不是 64 的倍数
+template <class Set>
+static void testSet() {
+    Set a(130), b(130), full(130), empty(130);
+    full.fill();
+    CHECK(full.count() == 130);
+    CHECK(full.test(129));
+    a.set(3); a.set(64); a.set(129);
+    b.set(64); b.set(100);
+    CHECK(a.test(64) && !a.test(65));
+    CHECK(a.unionWith(b));
+    CHECK(!a.unionWith(b));
+    CHECK((elems(a) == std::set<size_t>{3, 64, 100, 129}));
+    CHECK(a.intersectWith(b));
+    CHECK(!a.intersectWith(b));
+    CHECK(a == b);
+    a.reset(64);
+    CHECK(a.count() == 1);
+
+    // out = gen ∪ (in − kill)
+    Set gen(130), in(130), kill(130), out(130);
+    gen.set(1); in.set(2); in.set(70); kill.set(70); kill.set(1);
+    CHECK(out.transfer(gen, in, kill));
+    CHECK((elems(out) == std::set<size_t>{1, 2}));
+    CHECK(!out.transfer(gen, in, kill));
+    CHECK(out.transfer(empty, full, empty));
+    CHECK(out == full);
+}
+
+// 活跃变量，变量 a=0、b=1：
+//   B0: a = 1         -> B1
+//   B1: b = a + 1     -> B2, B3
+//   B2: a = b * 2     -> B1
+//   B3: return a
+template <class Set>
+static void testLiveness() {
+    FlowGraph g(4);
+    g.addEdge(0, 1); g.addEdge(1, 2); g.addEdge(1, 3); g.addEdge(2, 1);
+    FlowProblem<Set> p(FlowDirection::Backward, FlowMeet::Union, 2, 4);
+    p.kill[0].set(0);
+    p.gen[1].set(0); p.kill[1].set(1);
+    p.gen[2].set(1); p.kill[2].set(0);
+    p.gen[3].set(0);
+    FlowResult<Set> r = solveDataflow(g, p);
+    CHECK(elems(r.in[0]).empty());
+    CHECK((elems(r.out[0]) == std::set<size_t>{0}));
+    CHECK((elems(r.in[1]) == std::set<size_t>{0}));
+    CHECK((elems(r.out[1]) == std::set<size_t>{0, 1}));
+    CHECK((elems(r.in[2]) == std::set<size_t>{1}));
+    CHECK((elems(r.out[2]) == std::set<size_t>{0}));
+    CHECK((elems(r.in[3]) == std::set<size_t>{0}));
+}
+
+// 可用表达式 e0、e1，菱形控制流：B1 改写了 e0 的操作数，汇合处 e0 不可用
+template <class Set>
+static void testAvailable() {
+    FlowGraph g(4);
+    g.addEdge(0, 1); g.addEdge(0, 2); g.addEdge(1, 3); g.addEdge(2, 3);
+    FlowProblem<Set> p(FlowDirection::Forward, FlowMeet::Intersection, 2, 4);
+    p.gen[0].set(0);
+    p.kill[1].set(0); p.gen[1].set(1);
+    p.gen[2].set(1);
+    FlowResult<Set> r = solveDataflow(g, p);
+    CHECK(elems(r.in[0]).empty());
+    CHECK((elems(r.out[1]) == std::set<size_t>{1}));
+    CHECK((elems(r.out[2]) == std::set<size_t>{0, 1}));
+    CHECK((elems(r.in[3]) == std::set<size_t>{1}));
+}
+
+// 朴素解法：按块号反复整轮迭代直到不变，交汇规则与 solveDataflow 相同
+struct Reference {
+    std::vector<std::set<size_t>> in, out;
+};
+
+static Reference naiveSolve(const FlowGraph &g, bool forward, bool isUnion, size_t universe,
+                            const std::vector<std::set<size_t>> &gen, const std::vector<std::set<size_t>> &kill,
+                            const std::set<size_t> &boundary) {
+    size_t n = (size_t)g.size();
+    std::set<size_t> full;
+    for (size_t e = 0; e < universe; ++e) full.insert(e);
+    Reference r;
+    r.in.assign(n, isUnion ? std::set<size_t>() : full);
+    r.out = r.in;
+    auto &meetSets = forward ? r.in : r.out;
+    auto &flowSets = forward ? r.out : r.in;
+    const auto &from = forward ? g.pred : g.succ;
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (size_t b = 0; b < n; ++b) {
+            bool isBoundary = forward ? (int)b == g.entry : g.succ[b].empty();
+            std::set<size_t> m = isBoundary ? boundary : isUnion ? std::set<size_t>() : full;
+            for (int q : from[b]) {
+                const std::set<size_t> &o = flowSets[(size_t)q];
+                if (isUnion) {
+                    m.insert(o.begin(), o.end());
+                } else {
+                    std::set<size_t> keep;
+                    for (size_t e : m) if (o.count(e)) keep.insert(e);
+                    m.swap(keep);
+                }
+            }
+            std::set<size_t> f = gen[b];
+            for (size_t e : m) if (!kill[b].count(e)) f.insert(e);
+            meetSets[b] = m;
+            if (f != flowSets[b]) {
+                flowSets[b] = f;
+                changed = true;
+            }
+        }
+    }
+    return r;
+}
+
+// 随机控制流图（含回边、多个出口和走不到的块）上与朴素解法比较
+template <class Set>
+static void testRandom(unsigned seed, FlowDirection dir, FlowMeet meet) {
+    std::mt19937 rng(seed);
+    auto rand = [&](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); };
+    int n = rand(1, 40);
+    size_t universe = (size_t)rand(1, 200);
+    FlowGraph g(n);
+    for (int b = 0; b < n; ++b) {
+        for (int e = rand(0, 2); e > 0; --e) g.addEdge(b, rand(0, n - 1));
+    }
+    FlowProblem<Set> p(dir, meet, universe, n);
+    std::vector<std::set<size_t>> gen((size_t)n), kill((size_t)n);
+    std::set<size_t> boundary;
+    for (int b = 0; b < n; ++b) {
+        for (int k = rand(0, 4); k > 0; --k) {
+            size_t e = (size_t)rand(0, (int)universe - 1);
+            p.gen[(size_t)b].set(e); gen[(size_t)b].insert(e);
+        }
+        for (int k = rand(0, 4); k > 0; --k) {
+            size_t e = (size_t)rand(0, (int)universe - 1);
+            p.kill[(size_t)b].set(e); kill[(size_t)b].insert(e);
+        }
+    }
+    for (int k = rand(0, 3); k > 0; --k) {
+        size_t e = (size_t)rand(0, (int)universe - 1);
+        p.boundary.set(e); boundary.insert(e);
+    }
+
+    FlowResult<Set> r = solveDataflow(g, p);
+    Reference want = naiveSolve(g, dir == FlowDirection::Forward, meet == FlowMeet::Union,
+                                universe, gen, kill, boundary);
+    for (size_t b = 0; b < (size_t)n; ++b) {
+        CHECK(elems(r.in[b]) == want.in[b]);
+        CHECK(elems(r.out[b]) == want.out[b]);
+    }
+}
+
+int main() {
+    testSet<DenseBitSet>();
+    testSet<SparseBitSet>();
+    testLiveness<DenseBitSet>();
+    testLiveness<SparseBitSet>();
+    testAvailable<DenseBitSet>();
+    testAvailable<SparseBitSet>();
+
+    // 逆后序覆盖全部块，走不到的块也在内
+    FlowGraph g(5);
+    g.addEdge(0, 1); g.addEdge(1, 2); g.addEdge(2, 1); g.addEdge(4, 3);
+    std::vector<int> fwd = flowOrder(g, true);
+    CHECK((std::vector<int>(fwd.begin(), fwd.begin() + 3) == std::vector<int>{0, 1, 2}));
+    CHECK((std::set<int>(fwd.begin(), fwd.end()).size() == 5));
+    std::vector<int> bwd = flowOrder(g, false);
+    CHECK(bwd.size() == 5);
+
+    for (unsigned seed = 1; seed <= 40; ++seed) {
+        testRandom<DenseBitSet>(seed, FlowDirection::Forward, FlowMeet::Union);
+        testRandom<DenseBitSet>(seed, FlowDirection::Backward, FlowMeet::Union);
+        testRandom<DenseBitSet>(seed, FlowDirection::Forward, FlowMeet::Intersection);
+        testRandom<SparseBitSet>(seed, FlowDirection::Backward, FlowMeet::Union);
+        testRandom<SparseBitSet>(seed, FlowDirection::Backward, FlowMeet::Intersection);
+    }
+
+    return testResult("DataflowTest");
+}
@@ -0,0 +1,36 @@
+#include "Diagnostics.h"
+#include "Check.h"
+#include <sstream>
+#include <string>
+
+static std::string written(const Diagnostics &d) {
+    std::ostringstream os;
+    d.write(os);
+    return os.str();
+}
+
+int main() {
+    Diagnostics empty;
+    CHECK(empty.empty());
+    CHECK(written(empty).empty());
+
+    // 按行输出；同一行按类别码排序，与报告顺序无关；最后一条不带换行
+    Diagnostics d;
+    d.report(7, ErrorCode::MissingSemicn);
+    d.report(3, ErrorCode::Undefined);
+    d.report(7, ErrorCode::IllegalSymbol);
+    d.report(7, ErrorCode::Undefined);
+    d.report(7, ErrorCode::IllegalSymbol);
+    CHECK(d.size() == 5);
+    CHECK(!d.empty());
+    CHECK(written(d) == "3 c\n7 a\n7 a\n7 c\n7 i");
+
+    // 行号小于 1 按第 1 行记
+    Diagnostics clamp;
+    clamp.report(0, ErrorCode::BreakOutsideLoop);
+    clamp.report(-4, ErrorCode::IllegalSymbol);
+    CHECK(written(clamp) == "1 a\n1 m");
+
+    CHECK(errorCodeChar(ErrorCode::BreakOutsideLoop) == 'm');
+    return testResult("DiagnosticsTest");
+}
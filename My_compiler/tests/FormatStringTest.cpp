@@ -0,0 +1,59 @@
+#include "FormatString.h"
+#include "Check.h"
+#include "MipsSim.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// 把拆分结果写成便于比较的形式：常量段原样，槽写作 {}
+static std::string render(const FormatString &fs, const StringPool &pool) {
+    std::string s;
+    for (const FormatPiece &p : fs.pieces) s += p.isSlot ? "{}" : "[" + pool.text(p.stringId) + "]";
+    return s;
+}
+
+int main() {
+    StringPool pool;
+
+    FormatString a = splitFormat("\"result[%d]=%d\\n\"", pool);
+    CHECK(a.slotCount == 2);
+    CHECK(a.pieces.size() == 5);
+    CHECK(render(a, pool) == "[result[]{}[]=]{}[\\n]");
+
+    // 相邻的 %d 之间、开头处不产生空段
+    FormatString b = splitFormat("\"%d%d\\n\"", pool);
+    CHECK(b.slotCount == 2);
+    CHECK(render(b, pool) == "{}{}[\\n]");
+    for (const FormatPiece &p : b.pieces) CHECK(p.isSlot || !pool.text(p.stringId).empty());
+
+    // "\n" 在两次调用中只存一份
+    CHECK(a.pieces[4].stringId == b.pieces[2].stringId);
+    CHECK(pool.size() == 3);
+
+    // 没有 %d 的串整体是一段；\ 后的字符不当作格式符
+    FormatString c = splitFormat("\"100\\%d\"", pool);
+    CHECK(c.slotCount == 0);
+    CHECK(c.pieces.size() == 1);
+
+    // emitData 的输出能被 mips_sim 汇编，并按 printf 的顺序打印出来
+    std::ostringstream asmText;
+    asmText << ".data\n";
+    pool.emitData(asmText);
+    asmText << ".text\n";
+    int value = 0;
+    for (const FormatPiece &p : a.pieces) {
+        if (p.isSlot) {
+            asmText << "li $a0, " << ++value << "\nli $v0, 1\nsyscall\n";
+        } else {
+            asmText << "la $a0, " << StringPool::labelOf(p.stringId) << "\nli $v0, 4\nsyscall\n";
+        }
+    }
+    MipsSim sim;
+    CHECK(sim.load(asmText.str()));
+    std::istringstream in;
+    std::string out;
+    CHECK(sim.run(in, out));
+    CHECK(out == "result[1]=2\n");
+
+    return testResult("FormatStringTest");
+}
@@ -0,0 +1,77 @@
+#include "MipsSim.h"
+#include "Check.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// 汇编并运行，返回程序输出；出错时输出以 "error: " 开头
+static std::string runAsm(const std::string &src, const std::string &input = "") {
+    MipsSim sim;
+    if (!sim.load(src)) return "error: " + sim.error();
+    std::istringstream in(input);
+    std::string out;
+    if (!sim.run(in, out)) return "error: " + sim.error();
+    return out;
+}
+
+int main() {
+    // 奇数长度的 .asciiz 之后，.word/.half 的标签要指向对齐后的地址
+    CHECK(runAsm(
+        ".data\n"
+        "s: .asciiz \"ab\"\n"
+        "w: .word 7\n"
+        "h:\n"
+        ".half 3\n"
+        ".text\n"
+        "la $t0, w\n"
+        "lw $a0, 0($t0)\n"
+        "li $v0, 1\n"
+        "syscall\n"
+        "lh $a0, h\n"
+        "syscall\n") == "73");
+
+    // .byte/.asciiz 不对齐，标签紧跟前一项
+    CHECK(runAsm(
+        ".data\n"
+        "a: .asciiz \"x\"\n"
+        "b: .asciiz \"yz\"\n"
+        ".text\n"
+        "la $a0, b\n"
+        "li $v0, 4\n"
+        "syscall\n") == "yz");
+
+    // 递归调用、读整数、伪指令展开
+    const std::string fact =
+        ".text\n"
+        "    li $v0, 5\n"
+        "    syscall\n"
+        "    move $a0, $v0\n"
+        "    jal fact\n"
+        "    move $a0, $v0\n"
+        "    li $v0, 1\n"
+        "    syscall\n"
+        "    li $v0, 10\n"
+        "    syscall\n"
+        "fact:\n"
+        "    addiu $sp, $sp, -8\n"
+        "    sw $ra, 4($sp)\n"
+        "    sw $a0, 0($sp)\n"
+        "    bgt $a0, 1, rec\n"
+        "    li $v0, 1\n"
+        "    j done\n"
+        "rec:\n"
+        "    addi $a0, $a0, -1\n"
+        "    jal fact\n"
+        "    lw $a0, 0($sp)\n"
+        "    mul $v0, $v0, $a0\n"
+        "done:\n"
+        "    lw $ra, 4($sp)\n"
+        "    addiu $sp, $sp, 8\n"
+        "    jr $ra\n";
+    CHECK(runAsm(fact, "10") == "3628800");
+
+    CHECK(runAsm(".text\nfoo $t0\n").rfind("error: line 2", 0) == 0);
+    CHECK(runAsm(".data\nx: .word 1\n.text\nlw $t0, y\n").rfind("error: line 4: undefined label", 0) == 0);
+
+    return testResult("MipsSimTest");
+}
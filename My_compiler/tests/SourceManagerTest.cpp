@@ -0,0 +1,64 @@
+#include "SourceManager.h"
+#include "Check.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+
+// 把 text 写进临时文件后交给 SourceManager 读取
+static std::string writeTemp(const std::string &text) {
+    std::random_device rd;
+    fs::path p = fs::temp_directory_path() / ("source_manager_test_" + std::to_string(rd()) + ".txt");
+    std::ofstream(p, std::ios::binary) << text;
+    return p.string();
+}
+
+int main() {
+    // 没有末尾换行：第一行、换行符本身、最后一行
+    std::string path = writeTemp("ab\ncd\nefg");
+    {
+        SourceManager sm(path);
+        CHECK(sm.buffer() == "ab\ncd\nefg");
+        // 第一次查询在 columnOf 中建立索引
+        CHECK(sm.columnOf(1) == 2);
+        CHECK(sm.lineOf(0) == 1);
+        CHECK(sm.columnOf(0) == 1);
+        // '\n' 属于它所结束的那一行
+        CHECK(sm.lineOf(2) == 1);
+        CHECK(sm.columnOf(2) == 3);
+        CHECK(sm.lineOf(3) == 2);
+        CHECK(sm.columnOf(3) == 1);
+        CHECK(sm.lineOf(8) == 3);
+        CHECK(sm.columnOf(8) == 3);
+        // 文件尾的偏移算在最后一行
+        CHECK(sm.lineOf(9) == 3);
+        CHECK(sm.lineCount() == 3);
+    }
+    fs::remove(path);
+
+    // 有末尾换行：文件尾位于换行之后的空行
+    path = writeTemp("x\n\n");
+    {
+        SourceManager sm(path);
+        CHECK(sm.lineCount() == 3);
+        CHECK(sm.lineOf(1) == 1);
+        CHECK(sm.lineOf(2) == 2);
+        CHECK(sm.columnOf(2) == 1);
+        CHECK(sm.lineOf(3) == 3);
+    }
+    fs::remove(path);
+
+    // 空文件只有一行
+    path = writeTemp("");
+    {
+        SourceManager sm(path);
+        CHECK(sm.lineCount() == 1);
+        CHECK(sm.lineOf(0) == 1);
+        CHECK(sm.columnOf(0) == 1);
+    }
+    fs::remove(path);
+
+    return testResult("SourceManagerTest");
+}
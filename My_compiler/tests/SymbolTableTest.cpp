@@ -0,0 +1,60 @@
+#include "SymbolTable.h"
+#include "Check.h"
+#include <iostream>
+#include <string>
+
+static SymbolInfo at(int line) {
+    SymbolInfo info;
+    info.line = line;
+    return info;
+}
+
+int main() {
+    Interner names;
+    int i = names.intern("i"), j = names.intern("j");
+    CHECK(names.intern("i") == i);
+    CHECK(names.name(j) == "j");
+
+    // 同一作用域重名
+    SymbolTable t;
+    CHECK(t.declare(i, at(1)));
+    CHECK(!t.declare(i, at(2)));
+    CHECK(t.lookup(i)->line == 1);
+
+    // 内层遮蔽，退出后恢复外层
+    t.enterScope();
+    CHECK(t.lookup(i)->line == 1);
+    CHECK(t.declare(i, at(5)));
+    CHECK(t.lookup(i)->line == 5);
+    CHECK(t.scopeOf(i) == 1);
+    t.exitScope();
+    CHECK(t.lookup(i)->line == 1);
+    CHECK(t.scopeOf(i) == 0);
+
+    // 兄弟作用域里的声明退出后不可见，也不妨碍再次声明
+    t.enterScope();
+    CHECK(t.declare(j, at(10)));
+    t.exitScope();
+    CHECK(t.lookup(j) == nullptr);
+    CHECK(t.scopeOf(j) == -1);
+    t.enterScope();
+    CHECK(t.lookup(j) == nullptr);
+    CHECK(t.declare(j, at(20)));
+    CHECK(t.lookup(j)->line == 20);
+    t.exitScope();
+
+    // 初始 64 槽、负载因子 1/2，超过 32 个名字会触发扩容
+    t.enterScope();
+    for (int k = 0; k < 200; ++k) CHECK(t.declare(names.intern("v" + std::to_string(k)), at(100 + k)));
+    for (int k = 0; k < 200; ++k) {
+        const SymbolInfo *s = t.lookup(names.intern("v" + std::to_string(k)));
+        CHECK(s && s->line == 100 + k);
+    }
+    CHECK(t.lookup(i)->line == 1);
+    t.exitScope();
+    CHECK(t.lookup(names.intern("v7")) == nullptr);
+    CHECK(t.lookup(i)->line == 1);
+    CHECK(t.depth() == 0);
+
+    return testResult("SymbolTableTest");
+}